@@ -0,0 +1,102 @@
+/**
+ * @file Arena.c
+ * @brief Implementation of the Arena memory allocator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of the functions for the Arena
+ * data type.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "Arena.h"
+
+Arena* createArena(size_t size)
+{
+	Arena* arena;
+	
+	size = arenaAllocSize(size);
+	
+	arena = (Arena*)malloc(sizeof(Arena));
+	if (arena == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	
+	arena->block = malloc(size + ARENA_ALIGNMENT - 1); //room to line the start up with a cache line
+	if (arena->block == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		free(arena);
+		exit(1);
+	}
+	
+	arena->base = (unsigned char*)(((uintptr_t)arena->block + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1));
+	arena->size = size;
+	arena->used = 0;
+	
+	return arena;
+}
+/*
+PSEUDOCODE:
+1) Round the size up to a whole number of cache lines
+2) Allocate the arena structure, throwing an error if this fails
+3) Allocate the memory block with extra room for alignment, throwing an error if this fails
+4) Set the start of the arena to the first cache line in the block
+5) Nothing has been handed out yet, return the arena
+*/
+
+void destroyArena(Arena* arena)
+{
+	if (arena != NULL) {
+		free(arena->block);
+		free(arena);
+	}
+}
+/*
+PSEUDOCODE:
+1) If the arena isn't null
+	2) Free its memory block and the arena structure
+*/
+
+size_t arenaAllocSize(size_t bytes)
+{
+	return (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+/*
+PSEUDOCODE:
+1) Round the number of bytes up to the next multiple of ARENA_ALIGNMENT
+*/
+
+void* arenaAlloc(Arena* arena, size_t bytes)
+{
+	void* memory;
+	
+	bytes = arenaAllocSize(bytes);
+	if (bytes > arena->size - arena->used) {
+		fprintf(stderr, "Error: Arena out of memory\n");
+		exit(1);
+	}
+	
+	memory = arena->base + arena->used;
+	arena->used += bytes;
+	
+	return memory;
+}
+/*
+PSEUDOCODE:
+1) Round the number of bytes up so the next allocation stays aligned
+2) If there isn't that much space left, throw an error and exit
+3) Hand out the memory after everything allocated so far
+4) Move the used count past it and return the memory
+*/
+
+void resetArena(Arena* arena)
+{
+	arena->used = 0;
+}
+/*
+PSEUDOCODE:
+1) Set the used count to 0, so the whole arena can be handed out again
+*/
@@ -0,0 +1,78 @@
+/**
+ * @file Arena.h
+ * @brief Header file for the Arena memory allocator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the definition of the Arena data type. An arena is one
+ * block of memory allocated up front, which smaller allocations are carved
+ * out of in order. Nothing is freed on its own: the whole arena is reset or
+ * destroyed at once, so a game sized up front makes no heap calls at all.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_ALIGNMENT 64 /**< every allocation starts on a cache line */
+
+/**
+ * @brief Structure representing an arena
+ */
+typedef struct {
+	unsigned char* base;  /**< start of the arena's memory, aligned to ARENA_ALIGNMENT */
+	void* block;          /**< block returned by malloc, freed by destroyArena */
+	size_t size;          /**< usable bytes in the arena */
+	size_t used;          /**< bytes handed out so far */
+} Arena;
+
+/**
+ * @brief create an arena of the given size
+ *
+ * @param size number of bytes the arena can hand out
+ * @return pointer to the new arena
+ */
+Arena* createArena(size_t size);
+
+/**
+ * @brief destroy an arena and free its memory
+ *
+ * everything allocated from the arena becomes invalid.
+ *
+ * @param pointer to the arena to destroy
+ */
+void destroyArena(Arena* arena);
+
+/**
+ * @brief allocate memory from an arena
+ *
+ * the memory is aligned to ARENA_ALIGNMENT. running out of space is an
+ * error, as arenas are sized up front.
+ *
+ * @param pointer to the arena
+ * @param number of bytes to allocate
+ * @return pointer to the allocated memory
+ */
+void* arenaAlloc(Arena* arena, size_t bytes);
+
+/**
+ * @brief get the number of bytes arenaAlloc uses for an allocation
+ *
+ * lets callers add up the size an arena needs before creating it.
+ *
+ * @param number of bytes requested
+ * @return bytes used, rounded up to ARENA_ALIGNMENT
+ */
+size_t arenaAllocSize(size_t bytes);
+
+/**
+ * @brief free everything allocated from an arena at once
+ *
+ * the arena keeps its memory, so the next allocations reuse it.
+ *
+ * @param pointer to the arena
+ */
+void resetArena(Arena* arena);
+
+#endif
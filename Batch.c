@@ -0,0 +1,747 @@
+/**
+ * @file Batch.c
+ * @brief Implementation of the lockstep batch engine
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the scalar and AVX2 play, pick and end steps of a
+ * GameBatch and the per-lane work around them. The steps only use mask
+ * arithmetic, compares and blends, so every lane does the same work and
+ * nothing depends on a branch. Each lane's generator is kept as four
+ * arrays of words, so the AVX2 pick step runs four xoshiro256** generators
+ * at once and finds the chosen hidden card with byte-wise bit counts.
+ * Cycle checks and starting games are left to plain per-lane code, as
+ * they only run in the lanes that need them.
+ *
+ * The AVX2 steps are compiled with per-function target attributes on GCC
+ * and Clang, so the rest of the program doesn't need -mavx2.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Batch.h"
+#include "Bits.h"
+#include "CardTables.h"
+#include "MatchScan.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BATCH_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+#define ALL_CARDS ((((uint64_t)1) << NUM_CARD_TYPES) - 1) /* bit of every card in a pack */
+#define SUIT_BITS 0x1FFFULL                                 /* bits of every card in the first suit */
+#define ALL_SET   (~(uint64_t)0)                            /* value of a set flag */
+
+_Static_assert(BATCH_LANES % 4 == 0 && BATCH_LANES <= 32, "lanes must fill AVX2 registers and a 32-bit mask");
+_Static_assert(BATCH_MAX_PLAYERS * HAND_SIZE + 1 <= NUM_CARD_TYPES, "one pack must deal every hand");
+
+/*
+ * Steps a lane's generator, the same steps as rngNext.
+ */
+static inline uint64_t laneNext(GameBatch* batch, int l)
+{
+	uint64_t result, mixed, t;
+	
+	mixed = batch->rng[1][l] * 5;
+	result = ((mixed << 7) | (mixed >> 57)) * 9;
+	t = batch->rng[1][l] << 17;
+	
+	batch->rng[2][l] ^= batch->rng[0][l];
+	batch->rng[3][l] ^= batch->rng[1][l];
+	batch->rng[1][l] ^= batch->rng[2][l];
+	batch->rng[0][l] ^= batch->rng[3][l];
+	batch->rng[2][l] ^= t;
+	batch->rng[3][l] = (batch->rng[3][l] << 45) | (batch->rng[3][l] >> 19);
+	
+	return result;
+}
+
+/*
+ * Random number below bound from a lane's generator, the same as
+ * rngBounded.
+ */
+static inline uint32_t laneBounded(GameBatch* batch, int l, uint32_t bound)
+{
+	uint64_t m;
+	uint32_t low, threshold;
+	
+	m = (laneNext(batch, l) >> 32) * (uint64_t)bound;
+	low = (uint32_t)m;
+	
+	if (low < bound) {
+		threshold = (0U - bound) % bound; //2^32 mod bound, the size of the uneven part
+		while (low < threshold) {
+			m = (laneNext(batch, l) >> 32) * (uint64_t)bound;
+			low = (uint32_t)m;
+		}
+	}
+	
+	return (uint32_t)(m >> 32);
+}
+
+/*
+ * Draws a random hidden card into the current hand of a lane.
+ */
+static inline void pickLane(GameBatch* batch, int l)
+{
+	uint64_t hidden, card;
+	
+	hidden = batch->hidden[l];
+	card = ((uint64_t)1) << selectSetBit(hidden, (int)laneBounded(batch, l, (uint32_t)countSetBits(hidden)));
+	batch->hidden[l] = hidden ^ card;
+	batch->current[l] |= card;
+}
+
+/*
+ * Play step one lane at a time. Flags are made with compares rather than
+ * branches, so the compiler can turn them into conditional moves.
+ */
+static uint32_t playBatchScalar(GameBatch* batch)
+{
+	uint64_t refill, moved, hand, playable, card;
+	uint32_t picks;
+	int l;
+	
+	picks = 0;
+	for (l = 0; l < BATCH_LANES; l++) {
+		refill = (batch->hidden[l] == 0 && batch->played[l] != batch->top[l]) ? ALL_SET : 0;
+		moved = (batch->played[l] ^ batch->top[l]) & refill; //every played card but the top one
+		batch->hidden[l] |= moved;
+		batch->played[l] ^= moved;
+		batch->refills[l] -= refill;
+		batch->shuffled[l] |= ((moved & (moved - 1)) != 0) ? ALL_SET : 0;
+		
+		hand = batch->hands[batch->seat[l]][l];
+		playable = hand & CARD_MATCH_MASKS[packedCardOfType(lowestSetBit(batch->top[l]))];
+		card = playable & (0 - playable); //lowest matching card, the first in a sorted hand
+		batch->current[l] = hand ^ card;
+		batch->played[l] |= card;
+		batch->top[l] = (playable != 0) ? card : batch->top[l];
+		
+		batch->stalled[l] = (playable == 0 && batch->hidden[l] == 0) ? ALL_SET : 0;
+		picks |= (uint32_t)(playable == 0 && batch->hidden[l] != 0) << l;
+	}
+	
+	return picks;
+}
+/*
+PSEUDOCODE:
+1) Loop over the lanes
+	2) If the hidden cards are empty and there is more than the top card on the pile, move the rest of the pile to them
+	3) Count the refill, and note if it moved two or more cards
+	4) AND the player's hand with the cards matching the top card, and play the lowest one if there is any
+	5) Flag the lane as stalled if nothing was played and there are no hidden cards
+	6) Set the lane's bit in the result if nothing was played but there is a card to pick
+7) Return the lanes that have to pick
+*/
+
+/*
+ * Pick step one lane at a time.
+ */
+static void pickBatchScalar(GameBatch* batch, uint32_t lanes)
+{
+	while (lanes != 0) {
+		pickLane(batch, lowestSetBit(lanes));
+		lanes &= lanes - 1;
+	}
+}
+
+/*
+ * End step one lane at a time.
+ */
+static uint32_t endBatchScalar(GameBatch* batch)
+{
+	uint64_t seat, hidden, slow;
+	uint32_t attention;
+	int l;
+	
+	attention = 0;
+	for (l = 0; l < BATCH_LANES; l++) {
+		seat = batch->seat[l];
+		batch->hands[seat][l] = batch->current[l];
+		batch->stalls[l] -= batch->stalled[l];
+		batch->turns[l]++;
+		batch->stallRun[l] = (batch->stallRun[l] + 1) & batch->stalled[l];
+		batch->seat[l] = (seat + 1 == (uint64_t)batch->numPlayers) ? 0 : seat + 1;
+		
+		hidden = batch->hidden[l];
+		slow = batch->stalled[l] | (((hidden & (hidden - 1)) == 0) ? ALL_SET : 0);
+		batch->window[l] &= slow; //the hidden order matters, so nothing saved can come back
+		batch->shuffled[l] &= slow;
+		
+		attention |= (uint32_t)(batch->current[l] == 0 || slow != 0 || batch->turns[l] >= SIM_MAX_TURNS) << l;
+	}
+	
+	return attention;
+}
+/*
+PSEUDOCODE:
+1) Loop over the lanes
+	2) Write the player's hand back to their seat
+	3) Count the turn and any stall, and extend or clear the run of stalls
+	4) Move on to the next seat
+	5) Unless the player stalled or there is at most one hidden card, clear the cycle check
+	6) Set the lane's bit in the result if the hand is empty, the cycle check is needed or the turn limit is reached
+7) Return the lanes that need a closer look
+*/
+
+#ifdef BATCH_X86
+
+/*
+ * Play step four lanes at a time.
+ */
+TARGET_AVX2 static uint32_t playBatchAvx2(GameBatch* batch)
+{
+	__m256i zero, one, rankBits, hidden, played, top, seat, refill, moved, hand, suit, match, rank;
+	__m256i playable, card, none, noneHidden;
+	uint32_t picks;
+	int l, p, s;
+	
+	zero = _mm256_setzero_si256();
+	one = _mm256_set1_epi64x(1);
+	rankBits = _mm256_set1_epi64x((long long)SUIT_BITS);
+	picks = 0;
+	
+	for (l = 0; l < BATCH_LANES; l += 4) {
+		hidden = _mm256_loadu_si256((const __m256i*)(batch->hidden + l));
+		played = _mm256_loadu_si256((const __m256i*)(batch->played + l));
+		top = _mm256_loadu_si256((const __m256i*)(batch->top + l));
+		seat = _mm256_loadu_si256((const __m256i*)(batch->seat + l));
+		
+		refill = _mm256_andnot_si256(_mm256_cmpeq_epi64(played, top), _mm256_cmpeq_epi64(hidden, zero));
+		moved = _mm256_and_si256(_mm256_xor_si256(played, top), refill);
+		hidden = _mm256_or_si256(hidden, moved);
+		played = _mm256_xor_si256(played, moved);
+		_mm256_storeu_si256((__m256i*)(batch->refills + l),
+		                    _mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(batch->refills + l)), refill));
+		_mm256_storeu_si256((__m256i*)(batch->shuffled + l),
+		                    _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(batch->shuffled + l)),
+		                                    _mm256_xor_si256(_mm256_cmpeq_epi64(_mm256_and_si256(moved, _mm256_sub_epi64(moved, one)), zero),
+		                                                     _mm256_cmpeq_epi64(zero, zero))));
+		
+		hand = zero;
+		for (p = 0; p < batch->numPlayers; p++) {
+			hand = _mm256_or_si256(hand, _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(batch->hands[p] + l)),
+			                                               _mm256_cmpeq_epi64(seat, _mm256_set1_epi64x(p))));
+		}
+		
+		match = zero;
+		for (s = 0; s < 4; s++) {
+			suit = _mm256_set1_epi64x((long long)(SUIT_BITS << (13 * s)));
+			match = _mm256_or_si256(match, _mm256_andnot_si256(_mm256_cmpeq_epi64(_mm256_and_si256(top, suit), zero), suit));
+		}
+		rank = _mm256_and_si256(_mm256_or_si256(_mm256_or_si256(top, _mm256_srli_epi64(top, 13)),
+		                                        _mm256_or_si256(_mm256_srli_epi64(top, 26), _mm256_srli_epi64(top, 39))),
+		                        rankBits);
+		match = _mm256_or_si256(match, _mm256_or_si256(_mm256_or_si256(rank, _mm256_slli_epi64(rank, 13)),
+		                                               _mm256_or_si256(_mm256_slli_epi64(rank, 26), _mm256_slli_epi64(rank, 39))));
+		
+		playable = _mm256_and_si256(hand, match);
+		card = _mm256_and_si256(playable, _mm256_sub_epi64(zero, playable)); //lowest matching card
+		none = _mm256_cmpeq_epi64(playable, zero);
+		noneHidden = _mm256_cmpeq_epi64(hidden, zero);
+		
+		_mm256_storeu_si256((__m256i*)(batch->current + l), _mm256_xor_si256(hand, card));
+		_mm256_storeu_si256((__m256i*)(batch->played + l), _mm256_or_si256(played, card));
+		_mm256_storeu_si256((__m256i*)(batch->top + l), _mm256_blendv_epi8(card, top, none));
+		_mm256_storeu_si256((__m256i*)(batch->hidden + l), hidden);
+		_mm256_storeu_si256((__m256i*)(batch->stalled + l), _mm256_and_si256(none, noneHidden));
+		picks |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_andnot_si256(noneHidden, none))) << l;
+	}
+	
+	return picks;
+}
+/*
+PSEUDOCODE:
+1) Loop over the lanes four at a time
+	2) Refill the lanes with no hidden cards and more than the top card on the pile, counting the refill
+	3) Note the refills that moved two or more cards
+	4) Gather each lane's current hand by comparing the seat with every seat number
+	5) Build the mask of cards matching the top card: the whole suit its bit is in, and its rank in every suit
+	6) AND it with the hand and play the lowest set bit, keeping the old top card where nothing matched
+	7) Flag the stalled lanes, and set the bits of the lanes that have to pick
+8) Return the lanes that have to pick
+*/
+
+/*
+ * Pick step four lanes at a time. Each group of lanes steps its
+ * generators together, counts the hidden cards with a nibble lookup and
+ * multiplies a random word by the count as rngBounded does. The chosen
+ * card is found byte by byte from running totals of the counts, then
+ * within its byte by halving. A lane rngBounded might draw again in,
+ * at most one pick in 80 million, is left as it was and picked on its own.
+ */
+TARGET_AVX2 static void pickBatchAvx2(GameBatch* batch, uint32_t lanes)
+{
+	__m256i zero, one, nibble, bitCounts, laneBits, spread, byteMask, byteOne;
+	__m256i pick, hidden, s0, s1, s2, s3, n0, n1, n2, n3, mixed, result, t;
+	__m256i byteCounts, bound, total, product, k, rare, shift, v, position, count, below, width, card;
+	uint32_t bits, retry;
+	int l, w;
+	
+	zero = _mm256_setzero_si256();
+	one = _mm256_set1_epi64x(1);
+	nibble = _mm256_set1_epi8(0x0F);
+	bitCounts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+	                             0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	laneBits = _mm256_setr_epi64x(1, 2, 4, 8);
+	spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8,
+	                          0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+	byteMask = _mm256_set1_epi64x(0xFF);
+	byteOne = _mm256_set1_epi8(1);
+	retry = 0;
+	
+	for (l = 0; l < BATCH_LANES; l += 4) {
+		bits = (lanes >> l) & 0xF;
+		if (bits == 0) {
+			continue;
+		}
+		pick = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), laneBits), laneBits);
+		hidden = _mm256_loadu_si256((const __m256i*)(batch->hidden + l));
+		s0 = _mm256_loadu_si256((const __m256i*)(batch->rng[0] + l));
+		s1 = _mm256_loadu_si256((const __m256i*)(batch->rng[1] + l));
+		s2 = _mm256_loadu_si256((const __m256i*)(batch->rng[2] + l));
+		s3 = _mm256_loadu_si256((const __m256i*)(batch->rng[3] + l));
+		
+		mixed = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1); //times 5
+		mixed = _mm256_or_si256(_mm256_slli_epi64(mixed, 7), _mm256_srli_epi64(mixed, 57));
+		result = _mm256_add_epi64(_mm256_slli_epi64(mixed, 3), mixed); //times 9
+		t = _mm256_slli_epi64(s1, 17);
+		n2 = _mm256_xor_si256(s2, s0);
+		n3 = _mm256_xor_si256(s3, s1);
+		n1 = _mm256_xor_si256(s1, n2);
+		n0 = _mm256_xor_si256(s0, n3);
+		n2 = _mm256_xor_si256(n2, t);
+		n3 = _mm256_or_si256(_mm256_slli_epi64(n3, 45), _mm256_srli_epi64(n3, 19));
+		
+		byteCounts = _mm256_add_epi8(_mm256_shuffle_epi8(bitCounts, _mm256_and_si256(hidden, nibble)),
+		                             _mm256_shuffle_epi8(bitCounts, _mm256_and_si256(_mm256_srli_epi16(hidden, 4), nibble)));
+		bound = _mm256_sad_epu8(byteCounts, zero);
+		total = _mm256_add_epi8(byteCounts, _mm256_slli_epi64(byteCounts, 8));
+		total = _mm256_add_epi8(total, _mm256_slli_epi64(total, 16));
+		total = _mm256_add_epi8(total, _mm256_slli_epi64(total, 32)); //byte b holds the set bits in bytes 0 to b
+		
+		product = _mm256_mul_epu32(_mm256_srli_epi64(result, 32), bound);
+		k = _mm256_srli_epi64(product, 32);
+		rare = _mm256_and_si256(pick, _mm256_cmpgt_epi64(bound, _mm256_and_si256(product, _mm256_set1_epi64x(0xFFFFFFFF))));
+		pick = _mm256_andnot_si256(rare, pick);
+		retry |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(rare)) << l;
+		
+		shift = _mm256_sad_epu8(_mm256_and_si256(_mm256_cmpgt_epi8(_mm256_add_epi8(_mm256_shuffle_epi8(k, spread), byteOne), total),
+		                                         byteOne),
+		                        zero); //bytes whose running total is at most k
+		shift = _mm256_slli_epi64(shift, 3);
+		k = _mm256_sub_epi64(k, _mm256_and_si256(_mm256_srlv_epi64(_mm256_slli_epi64(total, 8), shift), byteMask));
+		v = _mm256_and_si256(_mm256_srlv_epi64(hidden, shift), byteMask);
+		position = shift;
+		for (w = 4; w > 0; w >>= 1) {
+			width = _mm256_set1_epi64x(w);
+			count = _mm256_shuffle_epi8(bitCounts, _mm256_and_si256(v, _mm256_set1_epi64x((1 << w) - 1)));
+			below = _mm256_cmpgt_epi64(count, k); //the bit is in the lower half
+			k = _mm256_sub_epi64(k, _mm256_andnot_si256(below, count));
+			v = _mm256_blendv_epi8(_mm256_srlv_epi64(v, width), v, below);
+			position = _mm256_add_epi64(position, _mm256_andnot_si256(below, width));
+		}
+		card = _mm256_and_si256(_mm256_sllv_epi64(one, position), pick);
+		
+		_mm256_storeu_si256((__m256i*)(batch->hidden + l), _mm256_xor_si256(hidden, card));
+		_mm256_storeu_si256((__m256i*)(batch->current + l),
+		                    _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(batch->current + l)), card));
+		_mm256_storeu_si256((__m256i*)(batch->rng[0] + l), _mm256_blendv_epi8(s0, n0, pick));
+		_mm256_storeu_si256((__m256i*)(batch->rng[1] + l), _mm256_blendv_epi8(s1, n1, pick));
+		_mm256_storeu_si256((__m256i*)(batch->rng[2] + l), _mm256_blendv_epi8(s2, n2, pick));
+		_mm256_storeu_si256((__m256i*)(batch->rng[3] + l), _mm256_blendv_epi8(s3, n3, pick));
+	}
+	
+	while (retry != 0) {
+		pickLane(batch, lowestSetBit(retry));
+		retry &= retry - 1;
+	}
+}
+/*
+PSEUDOCODE:
+1) Loop over the lanes four at a time, skipping groups where nobody picks
+	2) Step the four generators and scramble their outputs
+	3) Count the hidden cards in each byte with a nibble lookup, and keep running totals of the counts
+	4) Multiply the top half of each output by the number of hidden cards, the top of the product is the card to take
+	5) Leave out the lanes where rngBounded might have to draw again
+	6) Find the byte holding the card from the running totals, then the bit within it by halving three times
+	7) Move the card from the hidden cards to the hand, and keep the new generator state, in the lanes that pick
+8) Pick the left out lanes one at a time
+*/
+
+/*
+ * End step four lanes at a time.
+ */
+TARGET_AVX2 static uint32_t endBatchAvx2(GameBatch* batch)
+{
+	__m256i zero, one, seat, hand, stalled, next, hidden, slow, turns, flags, atSeat;
+	uint32_t attention;
+	int l, p;
+	
+	zero = _mm256_setzero_si256();
+	one = _mm256_set1_epi64x(1);
+	attention = 0;
+	
+	for (l = 0; l < BATCH_LANES; l += 4) {
+		seat = _mm256_loadu_si256((const __m256i*)(batch->seat + l));
+		hand = _mm256_loadu_si256((const __m256i*)(batch->current + l));
+		stalled = _mm256_loadu_si256((const __m256i*)(batch->stalled + l));
+		
+		for (p = 0; p < batch->numPlayers; p++) {
+			atSeat = _mm256_cmpeq_epi64(seat, _mm256_set1_epi64x(p));
+			_mm256_storeu_si256((__m256i*)(batch->hands[p] + l),
+			                    _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i*)(batch->hands[p] + l)), hand, atSeat));
+		}
+		
+		_mm256_storeu_si256((__m256i*)(batch->stalls + l),
+		                    _mm256_sub_epi64(_mm256_loadu_si256((const __m256i*)(batch->stalls + l)), stalled));
+		turns = _mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(batch->turns + l)), one);
+		_mm256_storeu_si256((__m256i*)(batch->turns + l), turns);
+		_mm256_storeu_si256((__m256i*)(batch->stallRun + l),
+		                    _mm256_and_si256(_mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(batch->stallRun + l)), one), stalled));
+		next = _mm256_add_epi64(seat, one);
+		_mm256_storeu_si256((__m256i*)(batch->seat + l),
+		                    _mm256_andnot_si256(_mm256_cmpeq_epi64(next, _mm256_set1_epi64x(batch->numPlayers)), next));
+		
+		hidden = _mm256_loadu_si256((const __m256i*)(batch->hidden + l));
+		slow = _mm256_or_si256(stalled, _mm256_cmpeq_epi64(_mm256_and_si256(hidden, _mm256_sub_epi64(hidden, one)), zero));
+		_mm256_storeu_si256((__m256i*)(batch->window + l), _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(batch->window + l)), slow));
+		_mm256_storeu_si256((__m256i*)(batch->shuffled + l), _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(batch->shuffled + l)), slow));
+		
+		flags = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi64(hand, zero), slow),
+		                        _mm256_cmpgt_epi64(turns, _mm256_set1_epi64x(SIM_MAX_TURNS - 1)));
+		attention |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(flags)) << l;
+	}
+	
+	return attention;
+}
+/*
+PSEUDOCODE:
+1) Loop over the lanes four at a time
+	2) Blend each lane's hand back into the seat that played it
+	3) Count the turn and any stall, and extend or clear the run of stalls
+	4) Move on to the next seat, going back to 0 after the last one
+	5) Unless the player stalled or there is at most one hidden card, clear the cycle check
+	6) Flag the lanes with an empty hand, a cycle check to do or the turn limit reached
+7) Return the lanes that need a closer look
+*/
+
+#endif
+
+/*
+ * Hashes the position in a lane, for the cycle check. With at most one
+ * hidden card, the hands, the pile and the top card decide what it is.
+ */
+static uint64_t lanePosition(const GameBatch* batch, int l)
+{
+	uint64_t hash;
+	int p;
+	
+	hash = batch->top[l] ^ (batch->seat[l] << 56) ^ (batch->played[l] * 0x9E3779B97F4A7C15ULL);
+	for (p = 0; p < batch->numPlayers; p++) {
+		hash = (hash ^ (hash >> 32)) * 0xD6E8FEB86659FD93ULL + batch->hands[p][l];
+	}
+	return hash ^ (hash >> 32);
+}
+
+/*
+ * Brent's cycle check for one lane, the same as stateHashCheckCycle.
+ * Returns 1 if the position came back with no random choice in between.
+ */
+static int laneCycles(GameBatch* batch, int l)
+{
+	uint64_t position;
+	
+	position = lanePosition(batch, l);
+	
+	if (batch->shuffled[l] || batch->window[l] == 0) {
+		batch->mark[l] = position;
+		batch->sinceMark[l] = 0;
+		batch->window[l] = 1;
+		batch->shuffled[l] = 0;
+		return 0;
+	}
+	
+	if (position == batch->mark[l]) {
+		return 1;
+	}
+	
+	if (++batch->sinceMark[l] == batch->window[l]) {
+		batch->mark[l] = position;
+		batch->sinceMark[l] = 0;
+		batch->window[l] *= 2;
+	}
+	
+	return 0;
+}
+/*
+PSEUDOCODE:
+1) Hash the lane's position
+2) If a refill shuffled cards or nothing is saved yet, save this position and start a window of one turn
+3) If the position is the saved one, report a cycle
+4) Otherwise count the turn, and when the window is full save this position and double the window
+*/
+
+/*
+ * Starts the next game of the simulation in a lane, or empties the lane
+ * if there are no games left. An empty lane keeps a valid top card and
+ * no other cards, so the steps can still read it.
+ */
+static void startLaneGame(GameBatch* batch, int l)
+{
+	unsigned char pack[NUM_CARD_TYPES];
+	unsigned char card;
+	uint64_t bit, dealt;
+	Rng rng;
+	int numDealt, i, j, p;
+	
+	for (p = 0; p < BATCH_MAX_PLAYERS; p++) {
+		batch->hands[p][l] = 0;
+	}
+	batch->seat[l] = 0;
+	batch->turns[l] = 0;
+	batch->refills[l] = 0;
+	batch->stalls[l] = 0;
+	batch->stallRun[l] = 0;
+	batch->window[l] = 0;
+	batch->shuffled[l] = 0;
+	
+	if (batch->nextGame >= batch->endGame) {
+		batch->top[l] = 1;
+		batch->played[l] = 1;
+		batch->hidden[l] = 0;
+		batch->live &= ~((uint32_t)1 << l);
+		return;
+	}
+	
+	rngSeed(&rng, simGameSeed(batch->seed, batch->nextGame++));
+	for (i = 0; i < 4; i++) {
+		batch->rng[i][l] = rng.s[i];
+	}
+	
+	for (i = 0; i < NUM_CARD_TYPES; i++) {
+		pack[i] = (unsigned char)i;
+	}
+	numDealt = batch->numPlayers * HAND_SIZE + 1;
+	dealt = 0;
+	p = 0;
+	for (i = 0; i < numDealt; i++) {
+		j = i + (int)laneBounded(batch, l, (uint32_t)(NUM_CARD_TYPES - i));
+		card = pack[j];
+		pack[j] = pack[i];
+		pack[i] = card;
+		bit = ((uint64_t)1) << card;
+		dealt |= bit;
+		if (i + 1 == numDealt) {
+			batch->top[l] = bit;
+		} else {
+			batch->hands[p][l] |= bit;
+			p = (p + 1 == batch->numPlayers) ? 0 : p + 1;
+		}
+	}
+	batch->played[l] = batch->top[l];
+	batch->hidden[l] = ALL_CARDS ^ dealt;
+	batch->live |= (uint32_t)1 << l;
+}
+/*
+PSEUDOCODE:
+1) Clear the lane's hands, turn, counters and cycle check
+2) If every game has been started, leave a single top card, take the lane out of play and stop
+3) Seed the lane's generator for the next game
+4) Shuffle just enough of a pack to deal, with Fisher-Yates from the front
+5) Deal the shuffled cards to each hand in turn and turn over the last one
+6) The cards not dealt are hidden
+*/
+
+/*
+ * Finishes the turn in a lane the end step flagged: finds a winner, a
+ * draw or the turn limit, and replaces a finished game with the next.
+ */
+static void finishLaneTurn(GameBatch* batch, int l, SimStats* stats)
+{
+	int winner;
+	
+	winner = GAME_RUNNING;
+	if (batch->current[l] == 0) {
+		winner = (batch->seat[l] == 0) ? batch->numPlayers - 1 : (int)batch->seat[l] - 1; //the seat that just played
+	} else if (batch->stallRun[l] >= (uint64_t)batch->numPlayers) {
+		winner = GAME_DRAWN; //every player in a row could do nothing
+	} else if ((batch->hidden[l] & (batch->hidden[l] - 1)) == 0 && laneCycles(batch, l)) {
+		winner = GAME_DRAWN;
+	}
+	
+	if (winner != GAME_RUNNING || batch->turns[l] >= SIM_MAX_TURNS) {
+		recordResult(stats, batch->numPlayers, winner, (int)batch->turns[l], (int)batch->refills[l], (int)batch->stalls[l]);
+		startLaneGame(batch, l);
+	}
+}
+/*
+PSEUDOCODE:
+1) If the hand is empty, the player who just moved has won
+2) Otherwise, if every player in a row stalled, the game is a draw
+3) Otherwise, if there is at most one hidden card and the position has come back, the game is a draw
+4) If the game is over or hit the turn limit, record it and start the next game in the lane
+*/
+
+int useBatchKernels(GameBatch* batch, BatchKernelKind kind)
+{
+	switch (kind) {
+	case BATCH_KERNEL_SCALAR:
+		batch->play = playBatchScalar;
+		batch->pick = pickBatchScalar;
+		batch->end = endBatchScalar;
+		return 1;
+#ifdef BATCH_X86
+	case BATCH_KERNEL_AVX2:
+		if (getMatchScan(MATCH_SCAN_AVX2) == NULL) {
+			return 0; //the match scan has already checked the processor for AVX2
+		}
+		batch->play = playBatchAvx2;
+		batch->pick = pickBatchAvx2;
+		batch->end = endBatchAvx2;
+		return 1;
+#endif
+	default:
+		return 0;
+	}
+}
+/*
+PSEUDOCODE:
+1) The scalar steps are always available
+2) On x86, use the AVX2 steps if the processor supports them
+3) Otherwise return 0 and leave the steps as they were
+*/
+
+const char* getBatchKernelName(BatchKernelKind kind)
+{
+	static const char* names[NUM_BATCH_KERNELS] = { "scalar", "avx2" };
+	
+	if ((unsigned)kind >= NUM_BATCH_KERNELS) {
+		return "unknown";
+	}
+	return names[kind];
+}
+
+int batchSupportsConfig(const GameConfig* config)
+{
+	int p;
+	
+	if (config->numPacks != 1 || config->useShoe || config->numPlayers < 2 || config->numPlayers > BATCH_MAX_PLAYERS) {
+		return 0;
+	}
+	for (p = 0; p < config->numPlayers; p++) {
+		if (config->strategies[p] != STRATEGY_FIRST_MATCH) {
+			return 0;
+		}
+	}
+	return 1;
+}
+/*
+PSEUDOCODE:
+1) Reject anything but one pack without a shoe and 2 to BATCH_MAX_PLAYERS players
+2) Reject the settings if any player has a strategy other than the first match
+3) Otherwise the batch engine can play them
+*/
+
+GameBatch* createGameBatch(const GameConfig* config)
+{
+	GameBatch* batch;
+	
+	if (!batchSupportsConfig(config)) {
+		fprintf(stderr, "Error: The batch engine plays one pack without a shoe, with 2 to %d players on the first match\n",
+		        BATCH_MAX_PLAYERS);
+		exit(1);
+	}
+	
+	batch = (GameBatch*)malloc(sizeof(GameBatch));
+	if (batch == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	
+	memset(batch, 0, sizeof(GameBatch));
+	batch->numPlayers = config->numPlayers;
+	if (!useBatchKernels(batch, BATCH_KERNEL_AVX2)) {
+		useBatchKernels(batch, BATCH_KERNEL_SCALAR);
+	}
+	
+	return batch;
+}
+/*
+PSEUDOCODE:
+1) Throw an error if the batch engine can't play the settings
+2) Allocate the batch, throwing an error if this fails
+3) Clear it and remember the number of players
+4) Use the AVX2 steps if the processor has them, otherwise the scalar ones
+*/
+
+void destroyGameBatch(GameBatch* batch)
+{
+	free(batch);
+}
+
+void startGameBatch(GameBatch* batch, uint64_t seed, long long firstGame, long long numGames)
+{
+	int l;
+	
+	batch->seed = seed;
+	batch->nextGame = firstGame;
+	batch->endGame = firstGame + numGames;
+	batch->live = 0;
+	
+	for (l = 0; l < BATCH_LANES; l++) {
+		startLaneGame(batch, l);
+	}
+}
+/*
+PSEUDOCODE:
+1) Remember the seed and the range of games
+2) Start a game in every lane, leaving lanes empty if there are too few games
+*/
+
+int stepGameBatch(GameBatch* batch, SimStats* stats)
+{
+	uint32_t lanes;
+	int l;
+	
+	batch->pick(batch, batch->play(batch) & batch->live);
+	
+	lanes = batch->end(batch) & batch->live;
+	while (lanes != 0) {
+		l = lowestSetBit(lanes);
+		lanes &= lanes - 1;
+		finishLaneTurn(batch, l, stats);
+	}
+	
+	return batch->live != 0;
+}
+/*
+PSEUDOCODE:
+1) Run the play step on every lane
+2) Run the pick step on the playing lanes that have to pick
+3) Run the end step on every lane
+4) Finish the turn in each playing lane the end step flagged
+5) Return 1 while any lane is still playing a game
+*/
+
+void simulateBatchGames(GameBatch* batch, uint64_t seed, long long firstGame, long long numGames, SimStats* stats)
+{
+	startGameBatch(batch, seed, firstGame, numGames);
+	while (stepGameBatch(batch, stats)) {
+		//every lane moves on one turn a step
+	}
+}
+/*
+PSEUDOCODE:
+1) Fill the lanes with the first games
+2) Step them until every game has been played
+*/
@@ -0,0 +1,196 @@
+/**
+ * @file Batch.h
+ * @brief Header file for the lockstep batch engine
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the GameBatch data type, which plays BATCH_LANES
+ * independent one-pack games side by side for rule-analysis sweeps. Each
+ * game is a lane of a structure of arrays, and with a single pack every
+ * card is unique, so each hand, the hidden cards and the played pile are
+ * 52-bit masks with bit cardTypeOf(card) set for each card held.
+ *
+ * A step advances every lane by one turn in three parts:
+ * - the play step refills empty hidden decks, finds each player's first
+ *   match with a few mask operations and plays it, without a branch
+ * - the pick step draws a random hidden card in the lanes whose player
+ *   could not play, stepping each lane's generator
+ * - the end step writes the hands back, moves to the next seat and
+ *   counts stalls, and flags the lanes that won or need a closer look
+ * Each step has an AVX2 version that does four lanes per instruction,
+ * picked at run time like the match scan, and both versions play exactly
+ * the same games. Games that finish are recorded and replaced by the next
+ * game straight away, so every lane stays busy until the batch runs out
+ * of games.
+ *
+ * The rules are the same as the Game engine with every player playing
+ * the first match. A card picked from a shuffled hidden deck is equally
+ * likely to be any hidden card, so the batch draws a random set bit
+ * instead of keeping the order. Each game is the same random game in
+ * distribution, though a seed doesn't give the same deal as in Game.
+ *
+ * Only one pack without a shoe, 2 to BATCH_MAX_PLAYERS players and the
+ * first match strategy fit in the masks, which batchSupportsConfig checks.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdint.h>
+#include "Random.h"
+#include "Simulator.h"
+
+#define BATCH_LANES       16  /**< games played side by side, a multiple of 4 and at most 32 */
+#define BATCH_MAX_PLAYERS 6   /**< most players one pack deals a hand and a first card to */
+
+/**
+ * @brief The versions of the play, pick and end steps
+ */
+typedef enum {
+	BATCH_KERNEL_SCALAR,  /**< one lane at a time, always available */
+	BATCH_KERNEL_AVX2,    /**< four lanes at a time */
+	NUM_BATCH_KERNELS
+} BatchKernelKind;
+
+struct GameBatch;
+
+/**
+ * @brief Play step: refill and play a matching card in every lane
+ *
+ * @param batch Pointer to the batch
+ * @return Mask with bit l set if the player in lane l has to pick a card
+ */
+typedef uint32_t (*BatchPlayFn)(struct GameBatch* batch);
+
+/**
+ * @brief Pick step: draw a random hidden card into the current hand
+ *
+ * @param batch Pointer to the batch
+ * @param lanes Mask with bit l set for each lane whose player has to pick
+ */
+typedef void (*BatchPickFn)(struct GameBatch* batch, uint32_t lanes);
+
+/**
+ * @brief End step: finish the turn in every lane
+ *
+ * @param batch Pointer to the batch
+ * @return Mask with bit l set if lane l won, stalled, hit the turn limit or has at most one hidden card
+ */
+typedef uint32_t (*BatchEndFn)(struct GameBatch* batch);
+
+/**
+ * @brief Structure holding every lane of a batch of games
+ *
+ * Every per-lane value is a 64-bit array indexed by lane, so four lanes
+ * load into one AVX2 register. Flags are all ones when set.
+ */
+typedef struct GameBatch {
+	uint64_t hands[BATCH_MAX_PLAYERS][BATCH_LANES]; /**< each seat's hand */
+	uint64_t current[BATCH_LANES];   /**< hand of the player taking the turn, between the steps */
+	uint64_t hidden[BATCH_LANES];    /**< face down cards */
+	uint64_t played[BATCH_LANES];    /**< face up cards, including the top one */
+	uint64_t top[BATCH_LANES];       /**< top played card, a single bit */
+	uint64_t seat[BATCH_LANES];      /**< seat of the player taking the turn */
+	uint64_t stalled[BATCH_LANES];   /**< set if the player could do nothing this turn */
+	uint64_t shuffled[BATCH_LANES];  /**< set if a refill moved two or more cards since the cycle check */
+	uint64_t stallRun[BATCH_LANES];  /**< turns in a row where the player could do nothing */
+	uint64_t window[BATCH_LANES];    /**< cycle check window, 0 if nothing is saved */
+	uint64_t turns[BATCH_LANES];     /**< turns taken so far */
+	uint64_t refills[BATCH_LANES];   /**< number of times the hidden cards were refilled */
+	uint64_t stalls[BATCH_LANES];    /**< turns where a player could do nothing */
+	uint64_t mark[BATCH_LANES];      /**< position saved by the cycle check */
+	uint64_t sinceMark[BATCH_LANES]; /**< turns since the position was saved */
+	uint64_t rng[4][BATCH_LANES];    /**< each lane's generator, one array per word of an Rng */
+	uint32_t live;                   /**< bit l is set while lane l is playing a game */
+	int numPlayers;                  /**< players in every game */
+	uint64_t seed;                   /**< seed of the whole simulation */
+	long long nextGame;              /**< number of the next game to start */
+	long long endGame;               /**< number one past the last game to play */
+	BatchPlayFn play;                /**< play step in use */
+	BatchPickFn pick;                /**< pick step in use */
+	BatchEndFn end;                  /**< end step in use */
+} GameBatch;
+
+/**
+ * @brief Check whether the batch engine can play games with some settings
+ *
+ * @param config Pointer to the settings of each game
+ * @return 1 for one pack without a shoe, 2 to BATCH_MAX_PLAYERS players all playing the first match, 0 otherwise
+ */
+int batchSupportsConfig(const GameConfig* config);
+
+/**
+ * @brief Create an empty batch
+ *
+ * Throws an error if batchSupportsConfig rejects the settings or there
+ * is not enough memory. Picks the fastest steps this processor supports.
+ *
+ * @param config Pointer to the settings of each game
+ * @return Pointer to the new batch, ready for startGameBatch
+ */
+GameBatch* createGameBatch(const GameConfig* config);
+
+/**
+ * @brief Destroy a batch
+ *
+ * @param batch Pointer to the batch to destroy, or NULL
+ */
+void destroyGameBatch(GameBatch* batch);
+
+/**
+ * @brief Fill every lane of a batch with its first game
+ *
+ * Game g uses the seed simGameSeed(seed, g), like the Game engine. Lanes
+ * left over when there are fewer games than lanes stay empty.
+ *
+ * @param batch Pointer to the batch
+ * @param seed Seed of the whole simulation
+ * @param firstGame Number of the first game to play
+ * @param numGames Number of games to play
+ */
+void startGameBatch(GameBatch* batch, uint64_t seed, long long firstGame, long long numGames);
+
+/**
+ * @brief Use one version of the play, pick and end steps
+ *
+ * @param batch Pointer to the batch
+ * @param kind Version to use
+ * @return 1 if it is used, 0 if this build or processor can't run it
+ */
+int useBatchKernels(GameBatch* batch, BatchKernelKind kind);
+
+/**
+ * @brief Get the name of a version of the steps
+ *
+ * @param kind Version to name
+ * @return Pointer to the name, such as "avx2"
+ */
+const char* getBatchKernelName(BatchKernelKind kind);
+
+/**
+ * @brief Advance every lane by one turn
+ *
+ * Finished games are added to the statistics and their lanes start the
+ * next game.
+ *
+ * @param batch Pointer to the batch
+ * @param stats Pointer to statistics the finished games are added to
+ * @return 1 while any lane is still playing, 0 once every game is done
+ */
+int stepGameBatch(GameBatch* batch, SimStats* stats);
+
+/**
+ * @brief Play games firstGame to firstGame + numGames - 1 in lockstep batches
+ *
+ * Makes no heap calls and never exits, so workers can run it on a batch
+ * made before they start.
+ *
+ * @param batch Pointer to a batch from createGameBatch
+ * @param seed Seed of the whole simulation
+ * @param firstGame Number of the first game to play
+ * @param numGames Number of games to play
+ * @param stats Pointer to statistics the games are added to
+ */
+void simulateBatchGames(GameBatch* batch, uint64_t seed, long long firstGame, long long numGames, SimStats* stats);
+
+#endif
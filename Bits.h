@@ -0,0 +1,96 @@
+/**
+ * @file Bits.h
+ * @brief Small bit manipulation helpers
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains portable helpers for finding and counting set bits,
+ * used by the card bitmasks. They map to a single instruction on GCC,
+ * Clang and MSVC and fall back to a plain loop elsewhere.
+ */
+
+#ifndef BITS_H
+#define BITS_H
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Get the position of the lowest set bit
+ *
+ * @param x Value to search, must not be 0
+ * @return Index of the lowest set bit, 0 to 63
+ */
+static inline int lowestSetBit(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	
+	_BitScanForward64(&index, x);
+	return (int)index;
+#else
+	int index;
+	
+	index = 0;
+	while ((x & 1) == 0) {
+		x >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+/**
+ * @brief Count the set bits in a value
+ *
+ * @param x Value to count
+ * @return Number of bits set in x
+ */
+static inline int countSetBits(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(x);
+#else
+	int count;
+	
+	count = 0;
+	while (x != 0) {
+		x &= x - 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+/**
+ * @brief Get the position of the k-th lowest set bit
+ *
+ * Halves the search window six times, counting the set bits in the lower
+ * half each time. The halves are chosen with masks rather than branches,
+ * as k is usually random and the branches would be mispredicted.
+ *
+ * @param x Value to search
+ * @param k Number of set bits to skip, must be less than countSetBits(x)
+ * @return Index of the set bit, 0 to 63
+ */
+static inline int selectSetBit(uint64_t x, int k)
+{
+	int position, width, count, upper;
+	
+	position = 0;
+	for (width = 32; width > 0; width >>= 1) {
+		count = countSetBits(x & ((((uint64_t)1) << width) - 1));
+		upper = -(k >= count); //all ones if the bit is in the upper half
+		k -= count & upper;
+		x >>= width & upper;
+		position += width & upper;
+	}
+	return position;
+}
+
+#endif
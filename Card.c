@@ -9,84 +9,47 @@
 
 #include <stdio.h>
 #include "Card.h"
+#include "Render.h"
+#include "CardTables.h"
 
 
 /*
   PSEUDOCODE: getSuitString
  1) Input:suit
- 2) Switch for suit:
- 3) Check each suit using switch statement
- 4) Return a string with the matching suit
- 5) If no suit matches, return "Unknown"
- 6) Output: string showing the suit
+ 2) If the suit is out of range, return "Unknown"
+ 3) Otherwise return its name from the generated SUIT_NAMES table
+ 4) Output: string showing the suit
  */
 
 const char* getSuitString(Suit suit)
 {
-	switch (suit) {
-	case CLUB:
-		return "Club";
-	case SPADE:
-		return "Spade";
-	case HEART:
-		return "Heart";
-	case DIAMOND:
-		return "Diamond";
-	default:
+	if ((unsigned)suit >= 4) {
 		return "Unknown";
 	}
+	return SUIT_NAMES[suit];
 }
 
 
 /*
  PSEUDOCODE: getSuitRank
  1) Input:rank
- 2) Switch for rank:
- 3) Check each rank using switch statement
- 4) Return a string with the matching rank
- 5) If no rank matches, return "Unknown"
- 6) Output: string showing the rank
+ 2) If the rank is out of range, return "Unknown"
+ 3) Otherwise return its name from the generated RANK_NAMES table
+ 4) Output: string showing the rank
  */
 
 const char* getRankString(Rank rank)
 {
-	switch (rank) {
-	case TWO:
-		return "Two";
-	case THREE:
-		return "Three";
-	case FOUR:
-		return "Four";
-	case FIVE:
-		return "Five";
-	case SIX:
-		return "Six";
-	case SEVEN:
-		return "Seven";
-	case EIGHT:
-		return "Eight";
-	case NINE:
-		return "Nine";
-	case TEN:
-		return "Ten";
-	case JACK:
-		return "Jack";
-	case QUEEN:
-		return "Queen";
-	case KING:
-		return "King";
-	case ACE:
-		return "Ace";
-	default:
+	if ((unsigned)rank >= 13) {
 		return "Unknown";
 	}
+	return RANK_NAMES[rank];
 }
 /*
   PSEUDOCODE: printCard
  1) Input: Card, card
- 2) Check rank
- 3) Check suit
- 4) Format and output result
+ 2) Draw the card into a small buffer using the rank and suit glyph tables
+ 3) Write the buffer out in one go
  5) Example : card = 5-heart
     returns card layout
 	 -----------
@@ -100,21 +63,12 @@ const char* getRankString(Rank rank)
 
 void printCard(Card card)
 {
+	RenderBuffer buffer;
+	char text[CARD_ROWS * (CARD_WIDTH + 2)];
 	
-	const char* ranks[] = { "2 ", "3 ", "4 ", "5 ", "6 ", "7 ", "8 ", "9 ", "10", "J ", "Q ", "K ", "A " }; // Arrays for rank symbols
-	const char* suits[] = { " club  ", " spade ", " heart ", "diamond" }; // Arrays for  suit symbols
-
-	const char* rankStr = ranks[card.rank];
-	const char* suitSymbol = suits[card.suit];
-
-	// Print ASCII card
-	printf(" _______ \n");
-	printf("|%s     |\n", rankStr); //puts rank in top corner
-	printf("|       | \n");
-	printf("|%s|\n", suitSymbol); // suit in the centre
-	printf("|       | \n");
-	printf("|     %s|\n", rankStr); // puts rank in bottom corner
-	printf(" ------- \n");
+	initRenderBuffer(&buffer, text, sizeof(text), stdout, 0);
+	renderCard(&buffer, packCard(card)); //copies the card from the glyph tables
+	flushRender(&buffer); // one write for the whole card
 }
 
 
@@ -122,12 +76,11 @@ void printCard(Card card)
 /*
   PSEUDOCODE: cardsMatch
  1) Input: card1, card2
- 2) Check if card1.suit == card2.suit, return true
- 3) else if card1.rank == card2.rank, return true
- 4) else return false
+ 2) Look up the mask of cards that match card1 in the generated table
+ 3) Return true if card2's bit is set in it, so the suits or the ranks are equal
  */
 
 int cardsMatch(Card card1, Card card2)
 {
-	return (card1.suit == card2.suit || card1.rank == card2.rank);
+	return (int)((CARD_MATCH_MASKS[packCard(card1)] >> cardTypeOf(packCard(card2))) & 1);
 }
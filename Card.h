@@ -7,12 +7,15 @@
  * This file contains the definition of the Card data type, including
  * enums types for Suit and Rank, and the Card structure itself.
  * The Card data type represents a single playing card from a standard
- * 52-card deck.
+ * 52-card deck. A PackedCard stores the same information in one byte and
+ * is the form used for cards stored inside a CardDeck.
  */
 
 #ifndef CARD_H
 #define CARD_H
 
+#include <stdint.h>
+
 /**
  * @brief Enums for card suits
  *
@@ -58,6 +61,110 @@ typedef struct {
 	Rank rank;  /**< The rank of the card */
 } Card;
 
+/**
+ * @brief A card packed into a single byte
+ *
+ * Bits 4-5 hold the suit and bits 0-3 hold the rank, so a card needs one
+ * byte instead of the eight used by Card. Comparing two packed cards as
+ * numbers orders them by suit first and then by rank, which is the order
+ * used by sortDeck.
+ */
+typedef uint8_t PackedCard;
+
+#define PACKED_SUIT_SHIFT 4     /**< bit position of the suit in a PackedCard */
+#define PACKED_RANK_MASK  0x0F  /**< bits holding the rank in a PackedCard */
+#define PACKED_SUIT_MASK  0x30  /**< bits holding the suit in a PackedCard */
+#define PACKED_CARD_LIMIT 64    /**< every PackedCard value is below this */
+#define NUM_CARD_TYPES    52    /**< distinct cards in a pack, numbered 0 to 51 by cardTypeOf */
+
+/**
+ * @brief Pack a card into a single byte
+ *
+ * @param card The card to pack
+ * @return The packed form of the card
+ */
+static inline PackedCard packCard(Card card)
+{
+	return (PackedCard)(((unsigned)card.suit << PACKED_SUIT_SHIFT) | (unsigned)card.rank);
+}
+
+/**
+ * @brief Get the suit of a packed card
+ *
+ * @param card The packed card
+ * @return The suit of the card
+ */
+static inline Suit packedSuit(PackedCard card)
+{
+	return (Suit)(card >> PACKED_SUIT_SHIFT);
+}
+
+/**
+ * @brief Get the rank of a packed card
+ *
+ * @param card The packed card
+ * @return The rank of the card
+ */
+static inline Rank packedRank(PackedCard card)
+{
+	return (Rank)(card & PACKED_RANK_MASK);
+}
+
+/**
+ * @brief Unpack a packed card back into a Card
+ *
+ * @param card The packed card
+ * @return The card with its suit and rank filled in
+ */
+static inline Card unpackCard(PackedCard card)
+{
+	Card result;
+	
+	result.suit = packedSuit(card);
+	result.rank = packedRank(card);
+	return result;
+}
+
+/**
+ * @brief Get the number of a card within a pack
+ *
+ * Cards are numbered 0 to NUM_CARD_TYPES - 1 in the same suit then rank
+ * order as sortDeck, which suits arrays and bitmasks indexed by card.
+ *
+ * @param card The packed card
+ * @return suit * 13 + rank
+ */
+static inline int cardTypeOf(PackedCard card)
+{
+	return packedSuit(card) * 13 + packedRank(card);
+}
+
+/**
+ * @brief Get the packed card with the given number within a pack
+ *
+ * @param type Card number from cardTypeOf, 0 to NUM_CARD_TYPES - 1
+ * @return The packed card
+ */
+static inline PackedCard packedCardOfType(int type)
+{
+	return (PackedCard)(((type / 13) << PACKED_SUIT_SHIFT) | (type % 13));
+}
+
+/**
+ * @brief Check if two packed cards match in suit or rank
+ *
+ * @param card1 First packed card to compare
+ * @param card2 Second packed card to compare
+ * @return 1 if cards match, 0 otherwise
+ */
+static inline int packedCardsMatch(PackedCard card1, PackedCard card2)
+{
+	unsigned diff;
+	
+	diff = (unsigned)(card1 ^ card2);
+	return ((diff & PACKED_SUIT_MASK) == 0 || (diff & PACKED_RANK_MASK) == 0);
+}
+
 /**
  * @brief Get string representation of a suit
  *
@@ -11,10 +11,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 #include "CardDeck.h"
+#include "Bits.h"
+#include "MatchScan.h"
+#include "Instrument.h"
+#include "Render.h"
 
 #define INITIAL_CAPACITY 10
+#define COUNTING_SORT_THRESHOLD 24 //decks this size or larger are sorted with a counting sort
 
 CardDeck* createCardDeck(void)
 {
@@ -26,7 +31,7 @@ CardDeck* createCardDeck(void)
 		exit(1);
 	}
 	
-	deck->cards = (Card*)malloc(INITIAL_CAPACITY * sizeof(Card)); //assigns memory for the card array
+	deck->cards = (PackedCard*)malloc(INITIAL_CAPACITY * sizeof(PackedCard)); //assigns memory for the card array
 	if (deck->cards == NULL) {
 		fprintf(stderr, "Error: Memory allocation failed\n");
 		free(deck);
@@ -35,28 +40,104 @@ CardDeck* createCardDeck(void)
 	
 	deck->size = 0;
 	deck->capacity = INITIAL_CAPACITY;
+	deck->index = NULL;
+	deck->arena = NULL;
+	deck->unshuffled = 0;
+	deck->lazyRng = NULL;
 	
 	return deck;
 }
 /*
 PSEUDOCODE:
 1) Initializes the deck as type CardDeck
-2) Allocates memory for the three parts of the CardDeck
+2) Allocates memory for the parts of the CardDeck
 3) If the deck remains empty
 	4) Allocation failed, throws error and exits program
 5) Allocates memory for the array of cards within the deck
 6) If the card array remains empty
 	7) Initialisation failed, throws error and exits program
 8) Initialises the current cards in the deck to 0, and the initial capacity to 10
-9) Returns the deck
+9) Starts with no match index, not in an arena and not lazily shuffled
+10) Returns the deck
+*/
+
+CardDeck* createCardDeckInArena(Arena* arena, int capacity)
+{
+	CardDeck* deck;
+	
+	deck = (CardDeck*)arenaAlloc(arena, sizeof(CardDeck));
+	deck->cards = (PackedCard*)arenaAlloc(arena, (size_t)capacity * sizeof(PackedCard));
+	deck->size = 0;
+	deck->capacity = capacity;
+	deck->index = NULL;
+	deck->arena = arena;
+	deck->unshuffled = 0;
+	deck->lazyRng = NULL;
+	
+	return deck;
+}
+/*
+PSEUDOCODE:
+1) Allocate the deck and its card array from the arena
+2) Initialise the deck as empty and not lazily shuffled, with the requested fixed capacity
+3) Remember the arena, so the deck is never reallocated or freed on its own
+4) Returns the deck
+*/
+
+size_t handBlockSize(int capacity)
+{
+	return arenaAllocSize(sizeof(CardDeck) + sizeof(HandIndex) + (size_t)capacity * sizeof(PackedCard));
+}
+/*
+PSEUDOCODE:
+1) Add up the deck, its match index and its cards, rounded up to a whole number of cache lines
+*/
+
+CardDeck* createHandInBlock(void* block, Arena* arena, int capacity)
+{
+	CardDeck* deck;
+	
+	deck = (CardDeck*)block;
+	_Static_assert(sizeof(CardDeck) % _Alignof(HandIndex) == 0, "the index must be aligned after the deck");
+	deck->index = (HandIndex*)(deck + 1);
+	deck->cards = (PackedCard*)(deck->index + 1);
+	deck->size = 0;
+	deck->capacity = capacity;
+	deck->arena = arena;
+	deck->unshuffled = 0;
+	deck->lazyRng = NULL;
+	memset(deck->index, 0, sizeof(HandIndex));
+	
+	return deck;
+}
+/*
+PSEUDOCODE:
+1) Put the deck at the start of the block, its match index straight after it and then its cards
+2) Initialise the deck as empty and not lazily shuffled, with the requested fixed capacity
+3) Remember the arena, so the deck is never reallocated or freed on its own
+4) Clear the match index and return the deck
 */
 
 CardDeck* createCardDeckWithPacks(int numPacks)
 {
 	CardDeck* deck;
-	int i, s, r;
 	
 	deck = createCardDeck();
+	addPacks(deck, numPacks);
+	
+	return deck;
+}
+/*
+PSEUDOCODE:
+1) Initializes the deck as type CardDeck
+2) Allocates memory for an empty deck using createCardDeck
+3) Adds the requested number of packs using addPacks
+4) Returns the completed deck
+*/
+
+void addPacks(CardDeck* deck, int numPacks)
+{
+	int i, s, r;
 	
 	for (i = 0; i < numPacks; i++) {
 		for (s = CLUB; s <= DIAMOND; s++) {
@@ -64,55 +145,230 @@ CardDeck* createCardDeckWithPacks(int numPacks)
 				Card card;
 				card.suit = (Suit)s;
 				card.rank = (Rank)r;
-				addCardToTop(deck, card);
+				addPackedCardToTop(deck, packCard(card));
 			}
 		}
 	}
-	
-	return deck;
 }
 /*
 PSEUDOCODE:
-1) Initializes the deck as type CardDeck
-2) Allocates memory for an empty deck using createCardDeck
-3) Runs 3 for loops, one for the ranks, one for the suits, and another for the number of packs in the deck
-	4) Adds a card with the correct rank and suit using addCardToTop for all packs requested
-5) Returns the completed deck
+1) Runs 3 for loops, one for the ranks, one for the suits, and another for the number of packs in the deck
+	2) Adds a card with the correct rank and suit using addPackedCardToTop for all packs requested
+*/
+
+void clearDeck(CardDeck* deck)
+{
+	deck->size = 0;
+	deck->unshuffled = 0;
+	if (deck->index != NULL) {
+		memset(deck->index, 0, sizeof(HandIndex));
+	}
+}
+/*
+PSEUDOCODE:
+1) Sets the size of the deck to 0, keeping its memory for reuse
+2) Nothing is left to shuffle lazily
+3) If the deck has a match index, clear it
 */
 
 void destroyCardDeck(CardDeck* deck)
 {
-	if (deck != NULL) {
+	if (deck != NULL && deck->arena == NULL) { //arena decks are freed with their arena
 		if (deck->cards != NULL) {
 			free(deck->cards);
 		}
+		free(deck->index); //free does nothing if there is no index
 		free(deck);
 	}
 }
 /*
 PSEUDOCODE:
-1) If the deck isn't null
+1) If the deck isn't null and doesn't belong to an arena
 	2) If the card array in the deck isn't null
 		3) Free the memory allocated for the card array
-	4) Free the memory allocated for the deck
+	4) Free the match index, if there is one
+	5) Free the memory allocated for the deck
 */
 
-void addCardToTop(CardDeck* deck, Card card)
+/*
+ * Records one more copy of a card in a hand's match index.
+ */
+static void indexAddCard(HandIndex* index, PackedCard card)
 {
-	if (deck->size >= deck->capacity) {
-		int newCapacity;
-		Card* newCards;
-		
-		newCapacity = deck->capacity * 2;
-		newCards = (Card*)realloc(deck->cards, newCapacity * sizeof(Card)); //temporary card array to hold existing cards, resizing old array with realloc
-		
-		if (newCards == NULL) {
-			fprintf(stderr, "Error: Memory reallocation failed\n");
+	Suit s;
+	Rank r;
+	
+	s = packedSuit(card);
+	r = packedRank(card);
+	index->counts[s][r]++;
+	index->suitCounts[s]++;
+	index->cardMask |= (uint64_t)1 << cardTypeOf(card);
+}
+
+/*
+ * Records one copy of a card leaving a hand, clearing its mask bit
+ * when it was the last copy.
+ */
+static void indexRemoveCard(HandIndex* index, PackedCard card)
+{
+	Suit s;
+	Rank r;
+	
+	s = packedSuit(card);
+	r = packedRank(card);
+	index->suitCounts[s]--;
+	if (--index->counts[s][r] == 0) {
+		index->cardMask &= ~((uint64_t)1 << cardTypeOf(card));
+	}
+}
+
+void enableHandIndex(CardDeck* deck)
+{
+	int i;
+	
+	if (deck->index == NULL && deck->arena != NULL) {
+		deck->index = (HandIndex*)arenaAlloc(deck->arena, sizeof(HandIndex));
+	} else if (deck->index == NULL) {
+		deck->index = (HandIndex*)malloc(sizeof(HandIndex));
+		if (deck->index == NULL) {
+			fprintf(stderr, "Error: Memory allocation failed\n");
 			exit(1);
 		}
-		
-		deck->cards = newCards;
-		deck->capacity = newCapacity;
+	}
+	
+	sortDeck(deck);
+	memset(deck->index, 0, sizeof(HandIndex));
+	for (i = 0; i < deck->size; i++) {
+		indexAddCard(deck->index, deck->cards[i]);
+	}
+}
+/*
+PSEUDOCODE:
+1) If the deck doesn't have an index yet
+	2) Allocate memory for one from the deck's arena or the heap, throwing an error if this fails
+3) Sort the deck, as an indexed hand is always kept sorted
+4) Clear the index and add every card in the deck to it
+*/
+
+/*
+ * Changes a heap deck's card array to exactly newCapacity cards.
+ */
+static void resizeDeck(CardDeck* deck, int newCapacity)
+{
+	PackedCard* newCards;
+	
+	INSTRUMENT_COUNT(COUNT_DECK_RESIZES, deck->size);
+	newCards = (PackedCard*)realloc(deck->cards, (size_t)newCapacity * sizeof(PackedCard)); //temporary card array to hold existing cards, resizing old array with realloc
+	
+	if (newCards == NULL) {
+		fprintf(stderr, "Error: Memory reallocation failed\n");
+		exit(1);
+	}
+	
+	deck->cards = newCards;
+	deck->capacity = newCapacity;
+}
+/*
+PSEUDOCODE:
+1) Resize the card array with realloc, which keeps the cards already in it
+2) Check the memory is successfully allocated and throw an error otherwise
+3) Set the deck's card array and capacity to the resized ones
+*/
+
+void reserveDeck(CardDeck* deck, int capacity)
+{
+	if (capacity <= deck->capacity) {
+		return;
+	}
+	
+	if (deck->arena != NULL) {
+		fprintf(stderr, "Error: Arena deck capacity exceeded\n");
+		exit(1);
+	}
+	
+	resizeDeck(deck, capacity);
+}
+/*
+PSEUDOCODE:
+1) If the deck can already hold that many cards, do nothing
+2) If the deck is in an arena its capacity is fixed, so throw an error and exit
+3) Resize the card array to the requested capacity
+*/
+
+void shrinkDeck(CardDeck* deck)
+{
+	int newCapacity;
+	
+	newCapacity = deck->size > INITIAL_CAPACITY ? deck->size : INITIAL_CAPACITY;
+	if (deck->arena == NULL && newCapacity < deck->capacity) {
+		resizeDeck(deck, newCapacity);
+	}
+}
+/*
+PSEUDOCODE:
+1) Work out the smallest capacity that holds the cards, but not less than the initial capacity
+2) If the deck is on the heap and bigger than that, resize it down
+*/
+
+/*
+ * Doubles the capacity of a full deck.
+ */
+static void growDeck(CardDeck* deck)
+{
+	reserveDeck(deck, deck->capacity * 2);
+}
+/*
+PSEUDOCODE:
+1) Reserve double the current capacity
+*/
+
+/*
+ * Fixes the top card of a lazily shuffled deck: one step of Fisher-Yates,
+ * drawing the same random numbers in the same order as shuffleDeck.
+ */
+static void settleTopCard(CardDeck* deck)
+{
+	int top, r;
+	PackedCard card;
+	
+	top = deck->unshuffled - 1;
+	if (top > 0) {
+		r = (int)rngBounded(deck->lazyRng, (uint32_t)(top + 1));
+		card = deck->cards[top];
+		deck->cards[top] = deck->cards[r];
+		deck->cards[r] = card;
+	}
+	deck->unshuffled--;
+}
+/*
+PSEUDOCODE:
+1) The top unshuffled position is the one to fix
+2) If it isn't the very bottom card
+	3) Swap it with a random card at or below it
+4) One fewer card is left to shuffle
+*/
+
+void settleDeck(CardDeck* deck)
+{
+	while (deck->unshuffled > 0) {
+		settleTopCard(deck);
+	}
+}
+/*
+PSEUDOCODE:
+1) While any cards are still waiting to be shuffled
+	2) Fix the top one of them
+*/
+
+void addPackedCardToTop(CardDeck* deck, PackedCard card)
+{
+	if (deck->index != NULL) {
+		addCardSorted(deck, unpackCard(card)); //an indexed hand must stay sorted
+		return;
+	}
+	
+	if (deck->size >= deck->capacity) {
+		growDeck(deck);
 	}
 	
 	deck->cards[deck->size] = card;
@@ -120,14 +376,61 @@ void addCardToTop(CardDeck* deck, Card card)
 }
 /*
 PSEUDOCODE:
-1) If the deck is at it's capacity
-	2) Create a new card array with double the capacity
-	3) Allocate the new array's memory and have it contain the cards in the old array
-	4) Check the memory is successfully allocated and throw an error otherwise
-	5) Set the deck's card array to the new longer card array
-	6) Set the deck's capacity to the doubled capacity
-7) Adds the card passed to the top of the deck
-8) Increases the size of the deck by one for the new card
+1) If the deck is an indexed hand, add the card in its sorted position instead
+2) If the deck is at it's capacity
+	3) Double the capacity with growDeck
+4) Adds the card passed to the top of the deck
+5) Increases the size of the deck by one for the new card
+*/
+
+void addCardToTop(CardDeck* deck, Card card)
+{
+	addPackedCardToTop(deck, packCard(card));
+}
+/*
+PSEUDOCODE:
+1) Packs the card and adds it to the top of the deck with addPackedCardToTop
+*/
+
+void addCardSorted(CardDeck* deck, Card card)
+{
+	PackedCard packed;
+	int low, high;
+	
+	packed = packCard(card);
+	settleDeck(deck);
+	if (deck->size >= deck->capacity) {
+		growDeck(deck);
+	}
+	deck->size++;
+	
+	low = 0;
+	high = deck->size - 1;
+	while (low < high) {
+		int mid;
+		
+		mid = low + (high - low) / 2;
+		if (deck->cards[mid] <= packed) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	
+	memmove(deck->cards + low + 1, deck->cards + low, (size_t)(deck->size - 1 - low));
+	deck->cards[low] = packed;
+	
+	if (deck->index != NULL) {
+		indexAddCard(deck->index, packed);
+	}
+}
+/*
+PSEUDOCODE:
+1) Pack the card, finish any lazy shuffle and make room for one more card, growing the deck if needed
+2) Binary search the existing cards for the first card that sorts after the new card
+3) Move the cards from that position up by one in one block
+4) Put the new card into the gap
+5) If the deck has a match index, add the card to it
 */
 
 Card removeCardFromTop(CardDeck* deck)
@@ -139,9 +442,17 @@ Card removeCardFromTop(CardDeck* deck)
 		exit(1);
 	}
 	
-	card = deck->cards[deck->size - 1];
+	if (deck->unshuffled == deck->size) {
+		settleTopCard(deck); //lazily shuffled deck, pick the top card now
+	}
+	
+	card = unpackCard(deck->cards[deck->size - 1]);
 	deck->size--; //deletes card, only way to access the card again is to increase size, which only happens when new card overwrites it
 	
+	if (deck->index != NULL) {
+		indexRemoveCard(deck->index, deck->cards[deck->size]);
+	}
+	
 	return card;
 }
 /*
@@ -149,28 +460,33 @@ PSEUDOCODE:
 1) Initialise a card
 2) Check that the deck has cards in it
 	3) If the deck is empty, throw error saying there is no card to remove and exit
-4) The initialised card is given the value of the card on top of the given deck
-5) The deck has it's size reduced by 1, which effectively deletes the topmost card,
+4) If the deck is lazily shuffled and the top card isn't picked yet, pick it now
+5) The initialised card is given the value of the card on top of the given deck
+6) The deck has it's size reduced by 1, which effectively deletes the topmost card,
 		as it cannot be interacted with unless overwritten using addCartToTop
-6) Returns the card removed from the deck
+7) If the deck has a match index, remove the card from it
+8) Returns the card removed from the deck
 */
 
 Card removeCardAtIndex(CardDeck* deck, int index)
 {
 	Card card;
-	int i;
 	
 	if (index < 0 || index >= deck->size) {
 		fprintf(stderr, "Error: Invalid index\n");
 		exit(1);
 	}
 	
-	card = deck->cards[index];
+	settleDeck(deck);
+	card = unpackCard(deck->cards[index]);
 	
-	for (i = index; i < deck->size - 1; i++) {
-		deck->cards[i] = deck->cards[i + 1]; //shifts cards after over by one
+	if (deck->index != NULL) {
+		indexRemoveCard(deck->index, deck->cards[index]);
 	}
 	
+	INSTRUMENT_COUNT(COUNT_REMOVE_SHIFTS, deck->size - index - 1);
+	memmove(deck->cards + index, deck->cards + index + 1, (size_t)(deck->size - index - 1)); //shifts cards after over by one in one block
+	
 	deck->size--; //deletes final card, which was now a duplicate of the second last card
 	
 	return card;
@@ -180,10 +496,12 @@ PSEUDOCODE:
 1) Initialise a card
 2) Check that the index given is within the number of cards in the deck
 	3) If not, throw error saying the index is outside the acceptable range of card
-4) The initialised card is given the value of the card at the index in the deck's card array
-5) The remaining cards after the removed card are shifted down by one to overwrite the removed card and fill the gap
-6) Reduces the size of the deck by 1
-7) Returns the card removed from the deck
+4) Finish any lazy shuffle, so every card is in its final position
+5) The initialised card is given the value of the card at the index in the deck's card array
+6) If the deck has a match index, remove the card from it
+7) The remaining cards after the removed card are shifted down by one in a single block to overwrite the removed card and fill the gap
+8) Reduces the size of the deck by 1
+9) Returns the card removed from the deck
 */
 
 Card peekTopCard(CardDeck* deck)
@@ -193,13 +511,18 @@ Card peekTopCard(CardDeck* deck)
 		exit(1);
 	}
 	
-	return deck->cards[deck->size - 1]; //size - 1 is the top card on deck
+	if (deck->unshuffled == deck->size) {
+		settleTopCard(deck); //lazily shuffled deck, pick the top card now
+	}
+	
+	return unpackCard(deck->cards[deck->size - 1]); //size - 1 is the top card on deck
 }
 /*
 PSEUDOCODE:
 1) Check that the deck isn't empty
 	2) If it is, throw an error saying can't check an empty deck and exit
-3) Return the value of the top card in the card array
+3) If the deck is lazily shuffled and the top card isn't picked yet, pick it now
+4) Return the value of the top card in the card array
 */
 
 int isDeckEmpty(CardDeck* deck)
@@ -221,67 +544,70 @@ PSEUDOCODE:
 1) Returns the size of the deck as an integer value
 */
 
-void shuffleDeck(CardDeck* deck)
+void shuffleDeck(CardDeck* deck, Rng* rng)
 {
-	CardDeck* tempDeck;
-	int n;
+	int i;
+	
+	deck->unshuffled = 0; //a full shuffle replaces any lazy one
+	INSTRUMENT_COUNT(COUNT_SHUFFLES, deck->size);
 	
 	if (deck->size <= 1) {
 		return; //returns deck as is if 1 or less cards, as it can't be shuffled
 	}
 	
-	tempDeck = createCardDeck();
-	n = deck->size;
-	
-	while (n > 0) {
+	for (i = deck->size - 1; i > 0; i--) {
 		int r;
-		Card card;
+		PackedCard card;
 		
-		r = rand() % n;
-		card = removeCardAtIndex(deck, r);
-		addCardToTop(tempDeck, card);
-		n--;
-	}
-	
-	while (tempDeck->size > 0) {
-		Card card;
-		card = removeCardFromTop(tempDeck);
-		addCardToTop(deck, card);
+		r = (int)rngBounded(rng, (uint32_t)(i + 1)); //random card from the part of the deck not yet shuffled
+		card = deck->cards[i];
+		deck->cards[i] = deck->cards[r];
+		deck->cards[r] = card;
 	}
-	
-	destroyCardDeck(tempDeck);
 }
 /*
 PSEUDOCODE:
-1) Create an empty temporary deck
-2) Check the size of the original deck
+1) Cancel any lazy shuffle, as the whole deck is about to be shuffled
+2) Check the size of the deck
 	3) If it is of size 1 or less, it can't be shuffled and is returned as is
-4) Store the initial size of the passed deck
-4) Do a while loop for as long as their are still cards in the original deck
-	5) Takes a random card from the original deck and adds it to the top of the temp deck
-6) Do a second loop while there are still cards in the temp deck
-	7) Return the now randomised order from the temp deck to the original deck
-8) Destroy the temporary deck
+4) Loop from the top card down to the second card
+	5) Pick a random card from the bottom of the deck up to and including the current card
+	6) Swap the random card with the current card, which fixes the current position
+7) Every ordering is equally likely and no extra deck is needed
 */
 
-void sortDeck(CardDeck* deck)
+void shuffleDeckLazy(CardDeck* deck, Rng* rng)
+{
+	deck->unshuffled = deck->size;
+	deck->lazyRng = rng;
+	INSTRUMENT_COUNT(COUNT_LAZY_SHUFFLES, deck->size);
+}
+/*
+PSEUDOCODE:
+1) Mark every card in the deck as not yet shuffled
+2) Remember the generator, so each card can be picked at random when it is drawn
+*/
+
+void sortDeckInsertion(CardDeck* deck)
 {
 	int i, j;
 	
+	deck->unshuffled = 0; //sorted order doesn't depend on any lazy shuffle
+	INSTRUMENT_COUNT(COUNT_SORTS, deck->size);
+	
 	for (i = 1; i < deck->size; i++) {
-		Card key;
+		PackedCard key;
 		
 		key = deck->cards[i];
 		j = i - 1; //set to card before key card to check all underneath card
 		
-		while (j >= 0 && 
-		       (deck->cards[j].suit > key.suit || 
-		        (deck->cards[j].suit == key.suit && deck->cards[j].rank > key.rank))) {
+		while (j >= 0 && deck->cards[j] > key) { //packed cards order by suit, then rank
 			deck->cards[j + 1] = deck->cards[j];
 			j--;
 		}
 		
 		deck->cards[j + 1] = key;
+		INSTRUMENT_COUNT(COUNT_SORT_COMPARES, i - 1 - j + (j >= 0)); //one compare per card moved, and one more unless it reached the bottom
 	}
 }
 /*
@@ -297,59 +623,181 @@ PSEUDOCODE:
 9) Returns the sorted deck
 */
 
-void printDeck(CardDeck* deck)
+void sortDeckCounting(CardDeck* deck)
 {
-	int i;
+	int counts[PACKED_CARD_LIMIT];
+	int i, value, pos;
+	
+	memset(counts, 0, sizeof(counts));
+	deck->unshuffled = 0; //sorted order doesn't depend on any lazy shuffle
+	INSTRUMENT_COUNT(COUNT_SORTS, deck->size);
 	
 	for (i = 0; i < deck->size; i++) {
-		printCard(deck->cards[i]);
-		if (i < deck->size - 1) {
-			printf(" "); //doesn't print space for final card for formatting
+		counts[deck->cards[i]]++; //packed cards are small numbers, so can be counted directly
+	}
+	
+	pos = 0;
+	for (value = 0; value < PACKED_CARD_LIMIT; value++) {
+		if (counts[value] > 0) {
+			memset(deck->cards + pos, value, (size_t)counts[value]);
+			pos += counts[value];
 		}
 	}
 }
 /*
 PSEUDOCODE:
-1) Loops for the size of the passed deck
-	2) Prints the cards value using printCard
-	3) If the card isn't the last in the deck
-		4) Add a comma between card listings
+1) Create a count for each of the possible packed card values, starting at 0
+2) Loop over the deck
+	3) Add one to the count of the current card
+4) Loop over the packed card values in order
+	5) Write that card into the deck as many times as it was counted
+6) The deck is now sorted by suit and then rank
 */
 
-int findMatchingCard(CardDeck* deck, Card card)
+void sortDeck(CardDeck* deck)
 {
-	int i;
+	if (deck->size >= COUNTING_SORT_THRESHOLD) {
+		sortDeckCounting(deck);
+	} else {
+		sortDeckInsertion(deck);
+	}
+}
+/*
+PSEUDOCODE:
+1) If the deck is large
+	2) Sort it with a counting sort, which takes time in proportion to the deck size
+3) Otherwise
+	4) Sort it with an insertion sort, which is quickest for small hands
+*/
+
+void printDeck(CardDeck* deck)
+{
+	RenderBuffer buffer;
 	
-	for (i = 0; i < deck->size; i++) {
-		if (cardsMatch(deck->cards[i], card)) {
-			return i;
-		}
+	settleDeck(deck);
+	initRenderBuffer(&buffer, NULL, 0, stdout, 0);
+	renderCards(&buffer, deck->cards, deck->size);
+	freeRenderBuffer(&buffer);
+}
+/*
+PSEUDOCODE:
+1) Finish any lazy shuffle and set up a render buffer for the console
+2) Draw all the cards in the deck side by side into it
+3) Write the whole deck out in one go and free the buffer
+*/
+
+int indexedCardPosition(const CardDeck* hand, int type)
+{
+	const HandIndex* index;
+	int position, suit, rank, s, r;
+	
+	index = hand->index;
+	suit = type / 13;
+	rank = type % 13;
+	
+	position = 0;
+	for (s = 0; s < suit; s++) {
+		position += index->suitCounts[s];
+	}
+	for (r = 0; r < rank; r++) {
+		position += index->counts[suit][r];
+	}
+	
+	return position;
+}
+/*
+PSEUDOCODE:
+1) Split the card number into its suit and rank
+2) Add up the cards in every lower suit and the lower ranks of that suit
+3) Return that total, which is the index of the card in the sorted hand
+*/
+
+/*
+ * Answers findMatchingCard for an indexed hand. The hand is sorted in card
+ * number order, so the first match is the lowest set bit of the playable
+ * cards.
+ */
+static int findMatchingCardIndexed(const CardDeck* hand, PackedCard card)
+{
+	uint64_t matches;
+	
+	matches = playableCards(hand, card);
+	if (matches == 0) {
+		return -1;
+	}
+	
+	return indexedCardPosition(hand, lowestSetBit(matches)); //lowest card sharing the suit or the rank
+}
+/*
+PSEUDOCODE:
+1) AND the hand's card mask with the card's row of the match table
+2) If nothing is left, return -1 as there is no match
+3) Return the position in the sorted hand of the lowest set bit, the first matching card
+*/
+
+int findMatchingCard(CardDeck* deck, Card card)
+{
+	if (deck->index != NULL) {
+		return findMatchingCardIndexed(deck, packCard(card));
 	}
 	
-	return -1;
+	settleDeck(deck);
+	
+	return findMatchingPacked(deck->cards, deck->size, packCard(card)); //checks 16 or 32 cards at a time where the processor can
 }
 /*
 PSEUDOCODE:
-1) Loops for the size of the passed deck
-	2) Checks the current indexed card against the passed card that's being searched for
-	3) If a match is found
-		4) Return the index of the first matching card
+1) If the deck has a match index, use it to find the match without a scan
+2) Finish any lazy shuffle
+3) Scan the packed cards for the first one matching the passed card, and return its index or -1
 */
 
 void transferCards(CardDeck* source, CardDeck* dest)
 {
-	int i;
+	int i, needed;
+	
+	if (source->size == 0) {
+		return;
+	}
+	
+	settleDeck(source); //the cards must arrive in their shuffled order
 	
-	for (i = 0; i < source->size; i++) {
-		addCardToTop(dest, source->cards[i]);
+	if (dest->index != NULL || source->index != NULL) {
+		for (i = 0; i < source->size; i++) {
+			addPackedCardToTop(dest, source->cards[i]); //an indexed hand takes each card into its sorted position
+		}
+	} else if (dest->size == 0 && dest->arena == source->arena) {
+		PackedCard* cards;
+		int capacity;
+		
+		cards = dest->cards;
+		capacity = dest->capacity;
+		dest->cards = source->cards; //dest takes over the source's cards without copying
+		dest->capacity = source->capacity;
+		dest->size = source->size;
+		source->cards = cards;
+		source->capacity = capacity;
+	} else {
+		needed = dest->size + source->size;
+		if (needed > dest->capacity) {
+			reserveDeck(dest, (dest->arena == NULL && needed < dest->capacity * 2) ? dest->capacity * 2 : needed);
+		}
+		memcpy(dest->cards + dest->size, source->cards, (size_t)source->size * sizeof(PackedCard));
+		dest->size = needed;
 	}
 	
-	source->size = 0;
+	clearDeck(source);
 }
 /*
 PSEUDOCODE:
-1) Loops for the size of the source deck
-	2) Adds the indexed card of the source deck to the top of the destination deck, 
-			starting at the bottom of the source deck
-3) Sets the size of the source deck to 0 as it is now empty
+1) If the source deck is empty, there is nothing to move
+2) Finish any lazy shuffle of the source deck
+3) If either deck is an indexed hand
+	4) Add the cards one at a time, so the hand stays sorted and indexed
+5) Otherwise if the destination is empty and both decks come from the same place
+	6) Swap the two card arrays, which moves every card without copying
+7) Otherwise
+	8) Reserve room for all the cards once, doubling the capacity if that is enough
+	9) Copy the source cards on top of the destination with a single memcpy
+10) Empties the source deck with clearDeck
 */
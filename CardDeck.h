@@ -8,7 +8,7 @@
  * dynamic memory allocation to support any number of cards.
  *
  * The structure of our code contains:
- * - cards: A dynamically allocated array of Card structures
+ * - cards: A dynamically allocated array of one-byte PackedCards
  * - size: The current number of cards in the deck
  * - capacity: The maximum number of cards the deck can hold before reallocation
  *
@@ -25,6 +25,23 @@
 #define CARDDECK_H
 
 #include "Card.h"
+#include "Random.h"
+#include "Arena.h"
+#include "CardTables.h"
+
+/**
+ * @brief Index of the cards held in a hand
+ *
+ * Counts how many of each card a hand holds, together with a bitmask of
+ * the cards held. ANDing the mask with a row of CARD_MATCH_MASKS gives
+ * every card that can follow a card, so findMatchingCard answers with a
+ * few bit operations instead of scanning the hand.
+ */
+typedef struct {
+	uint64_t cardMask;      /** bit cardTypeOf(card) is set if the hand holds the card */
+	int counts[4][13];      /** number of copies of each card, by suit and rank */
+	int suitCounts[4];      /** number of cards of each suit */
+} HandIndex;
 
 /**
  * @brief Structure representing a deck of cards
@@ -34,9 +51,13 @@
  * of cards.
  */
 typedef struct {
-	Card* cards;     /** dynamically allocated array of cards */
-	int size;        /** current number of cards in the deck */
-	int capacity;    /** maximum capacity before reallocation needed */
+	PackedCard* cards; /** dynamically allocated array of packed cards */
+	int size;          /** current number of cards in the deck */
+	int capacity;      /** maximum capacity before reallocation needed */
+	HandIndex* index;  /** match index for a sorted hand, NULL if not enabled */
+	Arena* arena;      /** arena the deck was allocated from, NULL for the heap */
+	int unshuffled;    /** cards at the bottom still waiting for a lazy shuffle */
+	Rng* lazyRng;      /** generator used to finish a lazy shuffle */
 } CardDeck;
 
 /**
@@ -48,6 +69,43 @@ typedef struct {
  */
 CardDeck* createCardDeck(void);
 
+/**
+ * @brief create a new empty card deck inside an arena
+ *
+ * the deck and its cards are allocated from the arena, so creating it makes
+ * no heap calls. its capacity is fixed: going over it is an error. the deck
+ * is freed when the arena is reset or destroyed, and destroyCardDeck does
+ * nothing for it.
+ *
+ * @param pointer to the arena
+ * @param number of cards the deck can hold
+ * @return pointer to newly created CardDeck
+ */
+CardDeck* createCardDeckInArena(Arena* arena, int capacity);
+
+/**
+ * @brief get the bytes needed for an indexed hand laid out in one block
+ *
+ * @param number of cards the hand can hold
+ * @return bytes createHandInBlock uses, a whole number of cache lines
+ */
+size_t handBlockSize(int capacity);
+
+/**
+ * @brief create an empty indexed hand in a block of memory
+ *
+ * lays the deck, its match index and its cards out back to back, so a
+ * turn touches as few cache lines as possible. several hands can share one
+ * arena allocation, each at its own multiple of handBlockSize. like an
+ * arena deck its capacity is fixed and destroyCardDeck does nothing for it.
+ *
+ * @param memory to use, at least handBlockSize(capacity) bytes
+ * @param pointer to the arena the memory came from
+ * @param number of cards the hand can hold
+ * @return pointer to the hand, at the start of the block
+ */
+CardDeck* createHandInBlock(void* block, Arena* arena, int capacity);
+
 /**
  * @brief create a new card deck with specified number of standard packs
  *
@@ -59,6 +117,48 @@ CardDeck* createCardDeck(void);
  */
 CardDeck* createCardDeckWithPacks(int numPacks);
 
+/**
+ * @brief add standard packs of cards to the top of a deck
+ *
+ * adds the specified number of 52 card packs, each in order of suit
+ * and then rank.
+ *
+ * @param pointer to the deck
+ * @param number of 52-card packs to add
+ */
+void addPacks(CardDeck* deck, int numPacks);
+
+/**
+ * @brief make sure the deck can hold at least the given number of cards
+ *
+ * grows the card array once, so adding that many cards needs no further
+ * reallocation. asking an arena deck for more than its fixed capacity is
+ * an error.
+ *
+ * @param pointer to the deck
+ * @param number of cards the deck should be able to hold
+ */
+void reserveDeck(CardDeck* deck, int capacity);
+
+/**
+ * @brief give back memory the deck isn't using
+ *
+ * shrinks the card array of a heap deck to fit its cards. arena decks
+ * are left as they are.
+ *
+ * @param pointer to the deck
+ */
+void shrinkDeck(CardDeck* deck);
+
+/**
+ * @brief remove every card from the deck
+ *
+ * the deck keeps its memory, so it can be refilled without allocating.
+ *
+ * @param pointer to the deck
+ */
+void clearDeck(CardDeck* deck);
+
 /**
  * @brief destroy a card deck and free its memory
  *
@@ -69,17 +169,54 @@ CardDeck* createCardDeckWithPacks(int numPacks);
  */
 void destroyCardDeck(CardDeck* deck);
 
+/**
+ * @brief turn the deck into an indexed hand
+ *
+ * sorts the deck and builds a HandIndex for it. from then on the deck is
+ * kept sorted: cards added with addCardToTop go into their sorted position,
+ * and every add and remove keeps the index up to date. findMatchingCard
+ * then uses the index and returns the same index as a scan would.
+ * an indexed hand must not be shuffled.
+ *
+ * @param pointer to the deck
+ */
+void enableHandIndex(CardDeck* deck);
+
 /**
  * @brief add a card to the top of the deck
  *
  * adds a card to the end of the deck (top). automatically
- * expands the deck capacity if needed.
+ * expands the deck capacity if needed. an indexed hand puts the card
+ * in its sorted position instead.
  *
  * @param pointer to the deck
  * @param card to add
  */
 void addCardToTop(CardDeck* deck, Card card);
 
+/**
+ * @brief add a packed card to the top of the deck
+ *
+ * same as addCardToTop, but takes the card in the packed form stored
+ * inside the deck, so no conversion is needed.
+ *
+ * @param pointer to the deck
+ * @param packed card to add
+ */
+void addPackedCardToTop(CardDeck* deck, PackedCard card);
+
+/**
+ * @brief add a card to a sorted deck, keeping it sorted
+ *
+ * finds the card's position with a binary search and moves the cards
+ * above it up in one block, so a sorted hand never needs a full sortDeck.
+ * the deck must already be sorted in the order used by sortDeck.
+ *
+ * @param pointer to the sorted deck
+ * @param card to add
+ */
+void addCardSorted(CardDeck* deck, Card card);
+
 /**
  * @brief remove and return the top card from the deck
  *
@@ -95,7 +232,8 @@ Card removeCardFromTop(CardDeck* deck);
  * @brief remove a card at a specific index
  *
  * removes the card at the specified index and returns it.
- * all cards after this position are moved down.
+ * all cards after this position are moved down in one block, so a
+ * sorted deck stays sorted.
  *
  * @param pointer to the deck
  * @param index of the card to remove
@@ -130,31 +268,84 @@ int isDeckEmpty(CardDeck* deck);
 int getDeckSize(CardDeck* deck);
 
 /**
- * @brief shuffle the deck using random card selection
+ * @brief shuffle the deck in place
  *
- * implements the shuffling algorithm specified in the assignment:
- * creates a new deck and repeatedly selects random cards from the
- * original deck to build the shuffled deck.
+ * uses the Fisher-Yates algorithm: walks down from the top card and swaps
+ * each card with a randomly selected card at or below it. every ordering is
+ * equally likely, the deck is shuffled in a single pass and no extra memory
+ * is allocated. all randomness comes from the given generator, so the same
+ * generator state always gives the same order.
  *
  * @param pointer to the deck to shuffle
+ * @param pointer to the random number generator to use
  */
-void shuffleDeck(CardDeck* deck);
+void shuffleDeck(CardDeck* deck, Rng* rng);
 
 /**
- * @brief sort the deck using insertion sort
+ * @brief shuffle the deck lazily, one card at a time as cards are drawn
+ *
+ * takes the same time however big the deck is. each time the top card is
+ * removed or looked at, a random card is picked from the cards not yet
+ * drawn and swapped to the top, which is one step of the Fisher-Yates
+ * shuffle. the cards come out in exactly the order shuffleDeck would have
+ * given with the same generator state, so only the cards actually drawn
+ * are paid for. the generator must stay valid until the shuffle is
+ * finished. operations that look at other cards finish the shuffle first.
+ *
+ * @param pointer to the deck to shuffle
+ * @param pointer to the random number generator to use
+ */
+void shuffleDeckLazy(CardDeck* deck, Rng* rng);
+
+/**
+ * @brief finish a lazy shuffle
+ *
+ * puts every card of a lazily shuffled deck into its final position. call
+ * this before reading the cards array of such a deck directly.
+ *
+ * @param pointer to the deck
+ */
+void settleDeck(CardDeck* deck);
+
+/**
+ * @brief sort the deck
  *
  * sorts cards first by suit (Club < Spade < Heart < Diamond),
  * then by rank within each suit (Two < Three < ... < Ace).
- * Uses insertion sort algorithm.
+ * small decks such as player hands use sortDeckInsertion, larger
+ * decks use sortDeckCounting.
  *
  * @param pointer to the deck to sort
  */
 void sortDeck(CardDeck* deck);
 
+/**
+ * @brief sort the deck using insertion sort
+ *
+ * same order as sortDeck. fastest for a few dozen cards, but takes
+ * time in proportion to the square of the deck size.
+ *
+ * @param pointer to the deck to sort
+ */
+void sortDeckInsertion(CardDeck* deck);
+
+/**
+ * @brief sort the deck using counting sort
+ *
+ * same order as sortDeck. counts how many of each of the 52 cards
+ * there are, then rewrites the deck in order, so it takes time in
+ * proportion to the deck size.
+ *
+ * @param pointer to the deck to sort
+ */
+void sortDeckCounting(CardDeck* deck);
+
 /**
  * @brief print all cards in the deck
  *
- * prints all cards in the deck on a single line with spaces
+ * prints all cards in the deck side by side with spaces, wrapping onto a
+ * new row of cards every CARDS_PER_LINE cards. the whole deck is written
+ * out with a single call.
  *
  * @param pointer to the deck to print
  */
@@ -164,6 +355,8 @@ void printDeck(CardDeck* deck);
  * @brief find index of first card matching the given card
  *
  * searches for a card that matches the given card in either suit or rank.
+ * an indexed hand answers from its HandIndex without scanning the cards,
+ * and other decks are scanned with findMatchingPacked.
  *
  * @param pointer to the deck to search
  * @param card to match against
@@ -171,11 +364,40 @@ void printDeck(CardDeck* deck);
  */
 int findMatchingCard(CardDeck* deck, Card card);
 
+/**
+ * @brief get the cards in an indexed hand that can follow a card
+ *
+ * one AND of the hand's card mask with the card's row of the generated
+ * match table.
+ *
+ * @param pointer to a hand with a HandIndex
+ * @param card to follow
+ * @return mask with bit cardTypeOf(c) set for every card c held that matches
+ */
+static inline uint64_t playableCards(const CardDeck* hand, PackedCard card)
+{
+	return cardsFollowing(hand->index->cardMask, card);
+}
+
+/**
+ * @brief get the position of a card in an indexed hand
+ *
+ * counts the cards that sort before it, without scanning the hand.
+ *
+ * @param pointer to a hand with a HandIndex
+ * @param card number, from cardTypeOf, of a card the hand holds
+ * @return index of the first copy of the card in the hand
+ */
+int indexedCardPosition(const CardDeck* hand, int type);
+
 /**
  * @brief transfer all cards from source deck to destination deck
  *
- * moves all cards from the source deck to the destination deck.
- * the source deck becomes empty after this operation.
+ * moves all cards from the source deck to the top of the destination deck,
+ * keeping their order. the source deck becomes empty after this operation.
+ * if the destination is empty the decks just swap card arrays, otherwise
+ * the destination grows at most once and the cards are copied in one block.
+ * cards moved into an indexed hand go into their sorted positions.
  *
  * @param pointer to source deck
  * @param pointer to destination deck
@@ -0,0 +1,257 @@
+/**
+ * @file CardRing.c
+ * @brief Implementation of the CardRing circular deck
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of all functions for the CardRing
+ * data type.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CardRing.h"
+
+#define MIN_RING_CAPACITY 16
+
+/*
+ * Makes room for at least minCapacity cards, unwrapping the cards so the
+ * bottom card is at position 0 of the new array.
+ */
+static void growRing(CardRing* ring, int minCapacity)
+{
+	int newCapacity, firstPart;
+	PackedCard* newCards;
+	
+	newCapacity = ring->capacity;
+	while (newCapacity < minCapacity) {
+		newCapacity *= 2;
+	}
+	if (newCapacity == ring->capacity) {
+		return;
+	}
+	
+	newCards = (PackedCard*)malloc((size_t)newCapacity * sizeof(PackedCard));
+	if (newCards == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	
+	firstPart = ring->capacity - ring->head; //cards from head to the end of the old array
+	if (firstPart > ring->size) {
+		firstPart = ring->size;
+	}
+	memcpy(newCards, ring->cards + ring->head, (size_t)firstPart);
+	memcpy(newCards + firstPart, ring->cards, (size_t)(ring->size - firstPart));
+	
+	free(ring->cards);
+	ring->cards = newCards;
+	ring->capacity = newCapacity;
+	ring->head = 0;
+}
+/*
+PSEUDOCODE:
+1) Double the capacity until it is big enough, stopping if it already is
+2) Allocate the new array, throwing an error if this fails
+3) Copy the cards from the head to the end of the old array, then the ones that wrapped round
+4) Free the old array and start the ring at position 0 of the new one
+*/
+
+CardRing* createCardRing(int capacity)
+{
+	CardRing* ring;
+	int size;
+	
+	size = MIN_RING_CAPACITY;
+	while (size < capacity) {
+		size *= 2;
+	}
+	
+	ring = (CardRing*)malloc(sizeof(CardRing));
+	if (ring == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	
+	ring->cards = (PackedCard*)malloc((size_t)size * sizeof(PackedCard));
+	if (ring->cards == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		free(ring);
+		exit(1);
+	}
+	
+	ring->capacity = size;
+	ring->head = 0;
+	ring->size = 0;
+	
+	return ring;
+}
+/*
+PSEUDOCODE:
+1) Round the capacity up to a power of two
+2) Allocate the ring and its array, throwing an error if this fails
+3) Start empty at position 0 and return the ring
+*/
+
+void destroyCardRing(CardRing* ring)
+{
+	if (ring != NULL) {
+		free(ring->cards);
+		free(ring);
+	}
+}
+/*
+PSEUDOCODE:
+1) If the ring isn't null, free its array and the ring itself
+*/
+
+PackedCard ringCardAt(const CardRing* ring, int position)
+{
+	return ring->cards[(ring->head + position) & (ring->capacity - 1)];
+}
+/*
+PSEUDOCODE:
+1) Count on from the head, wrapping round the end of the array with a mask
+*/
+
+void ringPushTop(CardRing* ring, PackedCard card)
+{
+	if (ring->size == ring->capacity) {
+		growRing(ring, ring->size + 1);
+	}
+	
+	ring->cards[(ring->head + ring->size) & (ring->capacity - 1)] = card;
+	ring->size++;
+}
+/*
+PSEUDOCODE:
+1) If the ring is full, grow it
+2) Put the card in the position after the top card and count it
+*/
+
+void ringPushBottom(CardRing* ring, PackedCard card)
+{
+	if (ring->size == ring->capacity) {
+		growRing(ring, ring->size + 1);
+	}
+	
+	ring->head = (ring->head - 1) & (ring->capacity - 1);
+	ring->cards[ring->head] = card;
+	ring->size++;
+}
+/*
+PSEUDOCODE:
+1) If the ring is full, grow it
+2) Move the head back one place, wrapping round, and put the card there
+3) Count the card
+*/
+
+PackedCard ringPopTop(CardRing* ring)
+{
+	if (ring->size == 0) {
+		fprintf(stderr, "Error: Cannot remove card from empty deck\n");
+		exit(1);
+	}
+	
+	ring->size--;
+	return ring->cards[(ring->head + ring->size) & (ring->capacity - 1)];
+}
+/*
+PSEUDOCODE:
+1) If the ring is empty, throw an error and exit
+2) Reduce the size by one and return the card that was on top
+*/
+
+PackedCard ringPopBottom(CardRing* ring)
+{
+	PackedCard card;
+	
+	if (ring->size == 0) {
+		fprintf(stderr, "Error: Cannot remove card from empty deck\n");
+		exit(1);
+	}
+	
+	card = ring->cards[ring->head];
+	ring->head = (ring->head + 1) & (ring->capacity - 1);
+	ring->size--;
+	
+	return card;
+}
+/*
+PSEUDOCODE:
+1) If the ring is empty, throw an error and exit
+2) Take the card at the head
+3) Move the head forward one place, wrapping round, and reduce the size by one
+4) Return the card
+*/
+
+PackedCard ringPeekTop(const CardRing* ring)
+{
+	if (ring->size == 0) {
+		fprintf(stderr, "Error: Cannot peek at empty deck\n");
+		exit(1);
+	}
+	
+	return ringCardAt(ring, ring->size - 1);
+}
+/*
+PSEUDOCODE:
+1) If the ring is empty, throw an error and exit
+2) Return the card at the top position
+*/
+
+void ringSpliceAllButTop(CardRing* source, CardRing* dest)
+{
+	PackedCard topCard;
+	int i;
+	
+	if (source->size <= 1) {
+		return;
+	}
+	
+	topCard = ringPopTop(source);
+	
+	if (dest->size == 0) {
+		CardRing swapped;
+		
+		swapped = *dest;
+		*dest = *source;
+		*source = swapped; //source now has dest's empty array
+	} else {
+		growRing(dest, dest->size + source->size);
+		for (i = 0; i < source->size; i++) {
+			ringPushTop(dest, ringCardAt(source, i));
+		}
+		source->size = 0;
+	}
+	
+	ringPushTop(source, topCard);
+}
+/*
+PSEUDOCODE:
+1) If the source has one card or none, there is nothing to move
+2) Take the top card off the source
+3) If the destination is empty
+	4) Swap the two rings, which moves every card without copying
+5) Otherwise
+	6) Grow the destination once, copy the cards onto it in order and empty the source
+7) Put the top card back on the source
+*/
+
+void ringAddDeck(CardDeck* deck, CardRing* ring)
+{
+	int i;
+	
+	settleDeck(deck); //a lazily shuffled deck must be in its final order before it is copied
+	growRing(ring, ring->size + deck->size);
+	for (i = 0; i < deck->size; i++) {
+		ringPushTop(ring, deck->cards[i]);
+	}
+}
+/*
+PSEUDOCODE:
+1) Finish any lazy shuffle of the deck
+2) Grow the ring once so every card fits
+3) Push the deck's cards onto the ring from bottom to top
+*/
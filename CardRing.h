@@ -0,0 +1,124 @@
+/**
+ * @file CardRing.h
+ * @brief Header file for the CardRing circular deck
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the definition of the CardRing data type, a deck kept
+ * in a circular buffer. Unlike a CardDeck, cards can be added and removed at
+ * the bottom as cheaply as at the top, and moving every card except the top
+ * one into an empty ring only swaps buffers. This suits rule variants that
+ * deal from the bottom, and refilling from very large shoes.
+ *
+ * The structure contains:
+ * - cards: a circular array of packed cards whose capacity is a power of two
+ * - head: the position of the bottom card in the array
+ * - size: the number of cards in the ring
+ */
+
+#ifndef CARDRING_H
+#define CARDRING_H
+
+#include "Card.h"
+#include "CardDeck.h"
+
+/**
+ * @brief Structure representing a deck kept in a circular buffer
+ *
+ * Card i from the bottom is stored at cards[(head + i) & (capacity - 1)].
+ */
+typedef struct {
+	PackedCard* cards;  /** circular array of packed cards */
+	int capacity;       /** size of the array, always a power of two */
+	int head;           /** position of the bottom card in the array */
+	int size;           /** current number of cards in the ring */
+} CardRing;
+
+/**
+ * @brief create a new empty ring
+ *
+ * @param number of cards the ring should hold before it has to grow
+ * @return pointer to newly created CardRing
+ */
+CardRing* createCardRing(int capacity);
+
+/**
+ * @brief destroy a ring and free its memory
+ *
+ * @param pointer to the ring to destroy
+ */
+void destroyCardRing(CardRing* ring);
+
+/**
+ * @brief get a card by its position from the bottom of the ring
+ *
+ * @param pointer to the ring
+ * @param position from the bottom, 0 to size - 1
+ * @return the card at that position
+ */
+PackedCard ringCardAt(const CardRing* ring, int position);
+
+/**
+ * @brief add a card to the top of the ring
+ *
+ * @param pointer to the ring
+ * @param card to add
+ */
+void ringPushTop(CardRing* ring, PackedCard card);
+
+/**
+ * @brief add a card to the bottom of the ring
+ *
+ * @param pointer to the ring
+ * @param card to add
+ */
+void ringPushBottom(CardRing* ring, PackedCard card);
+
+/**
+ * @brief remove and return the top card of the ring
+ *
+ * @param pointer to the ring, which must not be empty
+ * @return the card that was removed
+ */
+PackedCard ringPopTop(CardRing* ring);
+
+/**
+ * @brief remove and return the bottom card of the ring
+ *
+ * @param pointer to the ring, which must not be empty
+ * @return the card that was removed
+ */
+PackedCard ringPopBottom(CardRing* ring);
+
+/**
+ * @brief get the top card of the ring without removing it
+ *
+ * @param pointer to the ring, which must not be empty
+ * @return the top card
+ */
+PackedCard ringPeekTop(const CardRing* ring);
+
+/**
+ * @brief move every card except the top one from one ring to another
+ *
+ * the moved cards keep their order and go on top of the destination.
+ * if the destination is empty the two rings just swap buffers, so the
+ * move takes the same time however many cards there are.
+ *
+ * @param pointer to the source ring
+ * @param pointer to the destination ring
+ */
+void ringSpliceAllButTop(CardRing* source, CardRing* dest);
+
+/**
+ * @brief add every card of a deck to the top of a ring
+ *
+ * a lazily shuffled deck is settled first, so the ring gets the cards in
+ * the order they would be drawn. the deck keeps the same cards.
+ *
+ * @param pointer to the deck
+ * @param pointer to the ring
+ */
+void ringAddDeck(CardDeck* deck, CardRing* ring);
+
+#endif
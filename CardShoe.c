@@ -0,0 +1,129 @@
+/**
+ * @file CardShoe.c
+ * @brief Implementation of the CardShoe counted deck
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of all functions for the CardShoe
+ * data type.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CardShoe.h"
+
+#define TREE_TOP_STEP 32 /* highest power of two in the tree, used to search it */
+
+/*
+ * Adds delta to the count of one card type in the Fenwick tree.
+ */
+static void treeAdd(CardShoe* shoe, int type, int delta)
+{
+	int i;
+	
+	for (i = type + 1; i <= NUM_CARD_TYPES; i += i & -i) {
+		shoe->tree[i] += delta;
+	}
+}
+
+void clearShoe(CardShoe* shoe)
+{
+	memset(shoe, 0, sizeof(CardShoe));
+}
+/*
+PSEUDOCODE:
+1) Set every count, the tree and the total to 0
+*/
+
+void shoeAddPacks(CardShoe* shoe, int numPacks)
+{
+	int type;
+	
+	for (type = 0; type < NUM_CARD_TYPES; type++) {
+		shoe->counts[type] += numPacks;
+		treeAdd(shoe, type, numPacks);
+	}
+	shoe->total += numPacks * NUM_CARD_TYPES;
+}
+/*
+PSEUDOCODE:
+1) Loop over the 52 card types
+	2) Add one copy per pack to the count and the tree
+3) Add the new cards to the total
+*/
+
+void shoeAddCard(CardShoe* shoe, PackedCard card)
+{
+	int type;
+	
+	type = cardTypeOf(card);
+	shoe->counts[type]++;
+	treeAdd(shoe, type, 1);
+	shoe->total++;
+}
+/*
+PSEUDOCODE:
+1) Add one to the card's count, the tree and the total
+*/
+
+void shoeAddDeck(const CardDeck* deck, CardShoe* shoe)
+{
+	int added[NUM_CARD_TYPES];
+	int i, type;
+	
+	memset(added, 0, sizeof(added));
+	for (i = 0; i < deck->size; i++) {
+		added[cardTypeOf(deck->cards[i])]++;
+	}
+	
+	for (type = 0; type < NUM_CARD_TYPES; type++) {
+		if (added[type] > 0) {
+			shoe->counts[type] += added[type];
+			treeAdd(shoe, type, added[type]);
+		}
+	}
+	shoe->total += deck->size;
+}
+/*
+PSEUDOCODE:
+1) Count how many of each card type the deck holds
+2) Loop over the card types
+	3) Add that type's count to the shoe's count and tree in one step
+4) Add the deck's size to the total
+*/
+
+PackedCard shoeDrawRandom(CardShoe* shoe, Rng* rng)
+{
+	int target, position, step;
+	
+	if (shoe->total == 0) {
+		fprintf(stderr, "Error: Cannot remove card from empty deck\n");
+		exit(1);
+	}
+	
+	target = (int)rngBounded(rng, (uint32_t)shoe->total); //position of the drawn card among all cards
+	position = 0;
+	
+	for (step = TREE_TOP_STEP; step > 0; step >>= 1) {
+		if (position + step <= NUM_CARD_TYPES && shoe->tree[position + step] <= target) {
+			position += step;
+			target -= shoe->tree[position];
+		}
+	}
+	
+	shoe->counts[position]--; //position is now the type whose cards cover the target
+	treeAdd(shoe, position, -1);
+	shoe->total--;
+	
+	return packedCardOfType(position);
+}
+/*
+PSEUDOCODE:
+1) If the shoe is empty, throw an error and exit
+2) Pick a random position among all the cards in the shoe
+3) Walk down the Fenwick tree from its largest step
+	4) If the whole block under the next step is at or before the position, skip past it
+5) The walk stops at the card type holding the picked position
+6) Remove one copy of that card and return it
+*/
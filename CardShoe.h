@@ -0,0 +1,78 @@
+/**
+ * @file CardShoe.h
+ * @brief Header file for the CardShoe counted deck
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the definition of the CardShoe data type, a hidden deck
+ * stored as how many of each of the 52 cards it holds rather than as a list
+ * of cards. Drawing a uniformly random card uses a Fenwick tree over the
+ * counts, so it takes a handful of steps, and the size of a shoe is the same
+ * for one pack or a million. Drawing at random from a shoe gives cards with
+ * the same distribution as drawing from the top of a shuffled deck.
+ */
+
+#ifndef CARDSHOE_H
+#define CARDSHOE_H
+
+#include "Card.h"
+#include "CardDeck.h"
+#include "Random.h"
+
+/**
+ * @brief Structure representing a shoe as counts of each card
+ */
+typedef struct {
+	int counts[NUM_CARD_TYPES];      /** copies of each card, by cardTypeOf */
+	int tree[NUM_CARD_TYPES + 1];    /** Fenwick tree of the counts, indexed from 1 */
+	int total;                       /** number of cards in the shoe */
+} CardShoe;
+
+/**
+ * @brief empty a shoe
+ *
+ * @param pointer to the shoe
+ */
+void clearShoe(CardShoe* shoe);
+
+/**
+ * @brief add standard packs of cards to a shoe
+ *
+ * takes the same time however many packs are added.
+ *
+ * @param pointer to the shoe
+ * @param number of 52-card packs to add
+ */
+void shoeAddPacks(CardShoe* shoe, int numPacks);
+
+/**
+ * @brief add one card to a shoe
+ *
+ * @param pointer to the shoe
+ * @param card to add
+ */
+void shoeAddCard(CardShoe* shoe, PackedCard card);
+
+/**
+ * @brief add every card of a deck to a shoe
+ *
+ * only the number of each card is read, so a lazily shuffled deck needn't
+ * be settled first.
+ *
+ * @param pointer to the deck, which is left unchanged
+ * @param pointer to the shoe
+ */
+void shoeAddDeck(const CardDeck* deck, CardShoe* shoe);
+
+/**
+ * @brief remove and return a uniformly random card from a shoe
+ *
+ * every card left in the shoe is equally likely to be drawn.
+ *
+ * @param pointer to the shoe, which must not be empty
+ * @param pointer to the random number generator to use
+ * @return the card drawn
+ */
+PackedCard shoeDrawRandom(CardShoe* shoe, Rng* rng);
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file CardTables.h
+ * @brief Header file for the card lookup tables
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file declares the tables that gentables writes into CardTables.c
+ * at build time. They are indexed by PackedCard, so a lookup needs no
+ * conversion, and the values that aren't real cards hold nothing useful.
+ *
+ * A hand kept as a mask of card numbers (bit cardTypeOf(card) set for
+ * every card it holds) finds the cards that can follow a card with one
+ * AND: hand & CARD_MATCH_MASKS[card].
+ */
+
+#ifndef CARDTABLES_H
+#define CARDTABLES_H
+
+#include <stdint.h>
+#include "Card.h"
+#include "Render.h"
+
+/** bit t is set if the card matches card number t in suit or rank */
+extern const uint64_t CARD_MATCH_MASKS[PACKED_CARD_LIMIT];
+
+/** name of each suit, indexed by Suit */
+extern const char* const SUIT_NAMES[4];
+
+/** name of each rank, indexed by Rank */
+extern const char* const RANK_NAMES[13];
+
+/** every line of every drawn card, CARD_WIDTH characters and a terminator */
+extern const char CARD_GLYPHS[PACKED_CARD_LIMIT][CARD_ROWS][CARD_WIDTH + 1];
+
+/**
+ * @brief get the cards in a mask that can follow a card
+ *
+ * @param mask of card numbers, bit cardTypeOf(card) for each card held
+ * @param card to follow
+ * @return the bits of the mask for cards matching it in suit or rank
+ */
+static inline uint64_t cardsFollowing(uint64_t mask, PackedCard card)
+{
+	return mask & CARD_MATCH_MASKS[card];
+}
+
+#endif
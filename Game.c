@@ -0,0 +1,508 @@
+/**
+ * @file Game.c
+ * @brief Implementation of the silent game engine
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the game rules used by both the interactive game and
+ * the simulator. Nothing in here reads input or prints output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game.h"
+#include "Instrument.h"
+#include "ReplayLog.h"
+
+void dealHands(CardDeck* hiddenDeck, CardDeck* hands[], int numHands, int cardsPerHand)
+{
+	int i, h;
+	
+	for (i = 0; i < cardsPerHand; i++) {
+		for (h = 0; h < numHands; h++) {
+			addCardSorted(hands[h], removeCardFromTop(hiddenDeck));
+		}
+	}
+}
+/*
+PSEUDOCODE:
+1) Loop once for each card a hand should get
+	2) Loop over the hands
+		3) Move the top card of the hidden deck into the hand's sorted position
+*/
+
+/*
+ * Plays a card in the hand that matches the top played card, the first
+ * one if chooseCard is NULL or the one the strategy chooses otherwise.
+ * Returns 1 if a card was played, 0 if the hand has no match.
+ */
+static inline int playMatchingCard(CardDeck* hand, CardDeck* playedDeck, ChooseCardFn chooseCard, Card* card)
+{
+	uint64_t playable;
+	int matchIndex;
+	
+	if (chooseCard == NULL) {
+		matchIndex = findMatchingCard(hand, peekTopCard(playedDeck));
+	} else {
+		playable = playableCards(hand, playedDeck->cards[playedDeck->size - 1]);
+		matchIndex = (playable != 0) ? indexedCardPosition(hand, chooseCard(hand->index, playable)) : -1;
+	}
+	if (matchIndex == -1) {
+		return 0;
+	}
+	
+	*card = removeCardAtIndex(hand, matchIndex);
+	addCardToTop(playedDeck, *card);
+	return 1;
+}
+
+/*
+ * takeTurn for a player with a strategy, NULL to play the first match.
+ */
+static inline TurnAction takeChosenTurn(CardDeck* hand, CardDeck* hiddenDeck, CardDeck* playedDeck,
+                                        ChooseCardFn chooseCard, Card* card)
+{
+	if (playMatchingCard(hand, playedDeck, chooseCard, card)) {
+		return TURN_PLAYED;
+	}
+	
+	if (isDeckEmpty(hiddenDeck)) {
+		return TURN_STALLED;
+	}
+	
+	*card = removeCardFromTop(hiddenDeck);
+	addCardSorted(hand, *card); //hand stays sorted, no need for sortDeck
+	return TURN_PICKED;
+}
+
+TurnAction takeTurn(CardDeck* hand, CardDeck* hiddenDeck, CardDeck* playedDeck, Card* card)
+{
+	return takeChosenTurn(hand, hiddenDeck, playedDeck, NULL, card);
+}
+/*
+PSEUDOCODE:
+1) Play the first card in the hand that matches the top played card, or the one the strategy chooses
+2) If there was one, report it was played
+4) If the hidden deck is empty, report that the player could do nothing
+5) Otherwise move the top hidden card into the hand's sorted position and report it was picked
+*/
+
+int refillFromPlayed(CardDeck* hiddenDeck, CardDeck* playedDeck, Rng* rng)
+{
+	Card topCard;
+	
+	if (playedDeck->size <= 1) {
+		return 0;
+	}
+	
+	topCard = removeCardFromTop(playedDeck);
+	INSTRUMENT_COUNT(COUNT_REFILLS, playedDeck->size);
+	transferCards(playedDeck, hiddenDeck);
+	shuffleDeckLazy(hiddenDeck, rng); //cards are only shuffled as they are drawn
+	addCardToTop(playedDeck, topCard);
+	
+	return 1;
+}
+/*
+PSEUDOCODE:
+1) If there is only one played card, there is nothing to refill with, return 0
+2) Take the top played card off
+3) Move the rest of the played cards to the hidden deck and shuffle it lazily
+4) Put the top card back on the played deck and return 1
+*/
+
+/*
+ * Shoe version of takeTurn: plays a matching card, or draws a random card
+ * from the shoe into the hand.
+ */
+static TurnAction takeShoeTurn(CardDeck* hand, CardShoe* shoe, CardDeck* playedDeck, Rng* rng,
+                               ChooseCardFn chooseCard, Card* card)
+{
+	if (playMatchingCard(hand, playedDeck, chooseCard, card)) {
+		return TURN_PLAYED;
+	}
+	
+	if (shoe->total == 0) {
+		return TURN_STALLED;
+	}
+	
+	*card = unpackCard(shoeDrawRandom(shoe, rng));
+	addCardSorted(hand, *card);
+	return TURN_PICKED;
+}
+
+/*
+ * Shoe version of refillFromPlayed: counts every played card except the
+ * top one back into the shoe. Returns 1 if the shoe was refilled.
+ */
+static int refillShoe(CardShoe* shoe, CardDeck* playedDeck)
+{
+	Card topCard;
+	
+	if (playedDeck->size <= 1) {
+		return 0;
+	}
+	
+	topCard = removeCardFromTop(playedDeck);
+	INSTRUMENT_COUNT(COUNT_REFILLS, playedDeck->size);
+	shoeAddDeck(playedDeck, shoe);
+	clearDeck(playedDeck);
+	addCardToTop(playedDeck, topCard);
+	
+	return 1;
+}
+
+void initGameConfig(GameConfig* config, int numPacks)
+{
+	config->numPacks = numPacks;
+	config->numPlayers = DEFAULT_PLAYERS;
+	config->useShoe = 0;
+	memset(config->strategies, STRATEGY_FIRST_MATCH, sizeof(config->strategies));
+}
+/*
+PSEUDOCODE:
+1) Use the given number of packs and the default number of players
+2) Keep the hidden cards in a shuffled deck
+3) Every player plays the first matching card
+*/
+
+int minPacksForPlayers(int numPlayers)
+{
+	return (numPlayers * HAND_SIZE + 1 + 51) / 52;
+}
+/*
+PSEUDOCODE:
+1) Count a full hand for every player and the first played card
+2) Return the number of 52-card packs needed for that many cards, rounded up
+*/
+
+size_t gameArenaSize(const GameConfig* config)
+{
+	size_t deckSize;
+	
+	if (config->useShoe) {
+		return arenaAllocSize(sizeof(Game)) + arenaAllocSize(sizeof(CardShoe)); //the other decks grow on the heap
+	}
+	
+	deckSize = arenaAllocSize(sizeof(CardDeck)) + arenaAllocSize((size_t)config->numPacks * 52 * sizeof(PackedCard));
+	
+	return arenaAllocSize(sizeof(Game)) + 2 * deckSize
+	       + (size_t)config->numPlayers * handBlockSize(config->numPacks * 52);
+}
+/*
+PSEUDOCODE:
+1) If the game uses a shoe, only the game and the shoe go in the arena, whatever the number of packs
+2) Otherwise work out the size of one deck that can hold every card in the game
+3) Add up the game itself, the hidden and played decks, and the seat block with every player's hand
+*/
+
+Game* createGame(const GameConfig* config)
+{
+	Game* game;
+	
+	game = createGameInArena(createArena(gameArenaSize(config)), config);
+	game->ownsArena = 1;
+	
+	return game;
+}
+/*
+PSEUDOCODE:
+1) Create an arena just big enough for the game
+2) Create the game inside it, and remember that the game owns the arena
+*/
+
+Game* createGameInArena(Arena* arena, const GameConfig* config)
+{
+	Game* game;
+	int totalCards, p;
+	
+	if (config->numPlayers < 2 || config->numPlayers > MAX_PLAYERS) {
+		fprintf(stderr, "Error: A game needs 2 to %d players\n", MAX_PLAYERS);
+		exit(1);
+	}
+	if (config->numPacks < minPacksForPlayers(config->numPlayers)) {
+		fprintf(stderr, "Error: %d players need at least %d pack(s)\n", config->numPlayers,
+		        minPacksForPlayers(config->numPlayers));
+		exit(1);
+	}
+	for (p = 0; p < config->numPlayers; p++) {
+		if (config->strategies[p] >= NUM_STRATEGIES) {
+			fprintf(stderr, "Error: Player %d has an unknown strategy\n", p + 1);
+			exit(1);
+		}
+	}
+	
+	game = (Game*)arenaAlloc(arena, sizeof(Game));
+	game->arena = arena;
+	game->ownsArena = 0;
+	game->config = *config;
+	game->numPlayers = config->numPlayers;
+	game->recorder = NULL;
+	for (p = 0; p < MAX_PLAYERS; p++) {
+		game->chooseCard[p] = (p < config->numPlayers) ? strategyChooser((StrategyId)config->strategies[p]) : NULL;
+	}
+	
+	if (config->useShoe) {
+		game->shoe = (CardShoe*)arenaAlloc(arena, sizeof(CardShoe));
+		game->hiddenDeck = NULL;
+		game->playedDeck = createCardDeck(); //played cards and hands grow with the game, not the shoe
+		game->seats = NULL;
+		game->seatStride = 0;
+		for (p = 0; p < config->numPlayers; p++) {
+			game->players[p] = createCardDeck();
+			enableHandIndex(game->players[p]);
+		}
+	} else {
+		totalCards = config->numPacks * 52; //every deck can hold every card, so none ever has to grow
+		game->shoe = NULL;
+		game->hiddenDeck = createCardDeckInArena(arena, totalCards);
+		game->playedDeck = createCardDeckInArena(arena, totalCards);
+		game->seatStride = handBlockSize(totalCards);
+		game->seats = (unsigned char*)arenaAlloc(arena, (size_t)config->numPlayers * game->seatStride);
+		for (p = 0; p < config->numPlayers; p++) {
+			game->players[p] = createHandInBlock(game->seats + (size_t)p * game->seatStride, arena, totalCards);
+		}
+	}
+	
+	game->winner = GAME_RUNNING;
+	
+	return game;
+}
+/*
+PSEUDOCODE:
+1) Throw an error if the number of players is out of range, there aren't enough packs to deal to them
+	or a player's strategy is unknown
+2) Allocate the game from the arena, copy the configuration and look up each seat's strategy
+3) If the game uses a shoe
+	4) Allocate the shoe from the arena, and create the played deck and indexed hands on the heap
+5) Otherwise
+	6) Create the hidden and played decks in the arena, each big enough for every card
+	7) Allocate one seat block for every hand, and lay each indexed hand out at its seat's offset
+8) Return the game
+*/
+
+void destroyGame(Game* game)
+{
+	int p;
+	
+	if (game != NULL) {
+		destroyCardDeck(game->playedDeck); //does nothing for decks in the arena
+		for (p = 0; p < game->numPlayers; p++) {
+			destroyCardDeck(game->players[p]);
+		}
+		if (game->ownsArena) {
+			destroyArena(game->arena);
+		}
+	}
+}
+/*
+PSEUDOCODE:
+1) If the game isn't null
+	2) Destroy the played deck and hands, which only frees them if they are on the heap
+	3) If the game made its own arena, destroy the arena, which frees the game and everything in it
+*/
+
+void startGame(Game* game, uint64_t seed)
+{
+	int p, i;
+	
+	rngSeed(&game->rng, seed);
+	if (game->recorder != NULL) {
+		replayBeginGame(game->recorder, seed, &game->config);
+	}
+	
+	clearDeck(game->playedDeck);
+	for (p = 0; p < game->numPlayers; p++) {
+		clearDeck(game->players[p]);
+	}
+	
+	if (game->shoe != NULL) {
+		clearShoe(game->shoe);
+		shoeAddPacks(game->shoe, game->config.numPacks);
+		for (i = 0; i < HAND_SIZE; i++) {
+			for (p = 0; p < game->numPlayers; p++) {
+				addCardSorted(game->players[p], unpackCard(shoeDrawRandom(game->shoe, &game->rng)));
+			}
+		}
+		addPackedCardToTop(game->playedDeck, shoeDrawRandom(game->shoe, &game->rng));
+	} else {
+		clearDeck(game->hiddenDeck);
+		addPacks(game->hiddenDeck, game->config.numPacks);
+		shuffleDeckLazy(game->hiddenDeck, &game->rng);
+		dealHands(game->hiddenDeck, game->players, game->numPlayers, HAND_SIZE);
+		addCardToTop(game->playedDeck, removeCardFromTop(game->hiddenDeck));
+	}
+	
+	game->currentPlayer = 0;
+	game->winner = GAME_RUNNING;
+	game->turns = 0;
+	game->refills = 0;
+	game->stalls = 0;
+	initStateHash(&game->stateHash, game->players, game->numPlayers, game->playedDeck);
+}
+/*
+PSEUDOCODE:
+1) Seed the game's random number generator, and start a new game in the replay log if recording
+2) Empty every deck, keeping their memory
+3) If the game uses a shoe
+	4) Fill the shoe with the packs
+	5) Deal random cards from the shoe to the hands and turn over a random first card
+6) Otherwise
+	7) Fill the hidden deck with the packs and shuffle it lazily
+	8) Deal the hands and turn over the first card onto the played deck
+9) Reset the turn, winner and counters, and hash the dealt position
+*/
+
+TurnAction playGameTurn(Game* game, Card* card)
+{
+	CardDeck* hand;
+	TurnAction action;
+	CardDeck* playedDeck;
+	ChooseCardFn chooseCard;
+	int seat, hiddenCards, movedCards;
+	
+	seat = game->currentPlayer;
+	hand = gameHand(game, seat);
+	chooseCard = game->chooseCard[seat];
+	playedDeck = game->playedDeck;
+	movedCards = playedDeck->size - 1;
+	
+	if (game->shoe != NULL) {
+		if (game->shoe->total == 0 && refillShoe(game->shoe, playedDeck)) {
+			game->refills++;
+			hashRefill(&game->stateHash, playedDeck->cards[0], movedCards);
+		}
+		action = takeShoeTurn(hand, game->shoe, playedDeck, &game->rng, chooseCard, card);
+		hiddenCards = game->shoe->total;
+	} else {
+		if (isDeckEmpty(game->hiddenDeck) && refillFromPlayed(game->hiddenDeck, playedDeck, &game->rng)) {
+			game->refills++;
+			hashRefill(&game->stateHash, playedDeck->cards[0], movedCards);
+		}
+		action = takeChosenTurn(hand, game->hiddenDeck, playedDeck, chooseCard, card);
+		hiddenCards = game->hiddenDeck->size;
+	}
+	
+	if (game->recorder != NULL) {
+		replayRecordTurn(game->recorder, action);
+	}
+	if (action == TURN_PLAYED) {
+		hashPlayedCard(&game->stateHash, seat, packCard(*card));
+	} else if (action == TURN_PICKED) {
+		hashPickedCard(&game->stateHash, seat, packCard(*card));
+	} else {
+		game->stalls++;
+	}
+	
+	game->turns++;
+	game->currentPlayer = (seat + 1 == game->numPlayers) ? 0 : seat + 1; //round robin without a division
+	
+	if (isDeckEmpty(hand)) {
+		game->winner = seat;
+	} else if (stateHashEndTurn(&game->stateHash, action == TURN_STALLED, playedDeck->cards[playedDeck->size - 1],
+	                            game->currentPlayer, hiddenCards)) {
+		game->winner = GAME_DRAWN;
+	}
+	if (game->winner != GAME_RUNNING && game->recorder != NULL) {
+		replayEndGame(game->recorder, game->winner);
+	}
+	
+	return action;
+}
+/*
+PSEUDOCODE:
+1) If the hidden deck or shoe is empty, refill it from the played deck, count the refill and take the played cards out of the hash
+2) Take the current player's turn with their strategy, drawing from the shoe if the game uses one
+3) If the game is being recorded, add what the player did to the replay log
+4) Update the hash for the card played or picked, or count a stall if the player could do nothing
+5) Count the turn and move on to the next player
+6) If the player's hand is now empty, they are the winner
+7) Otherwise, if the game is stuck or has come back to an earlier position, it is a draw
+8) If the game has ended and is being recorded, record how it ended
+9) Return what the player did
+*/
+
+int playGame(Game* game, int maxTurns)
+{
+	Card card;
+	
+	while (game->winner == GAME_RUNNING && game->turns < maxTurns) {
+		playGameTurn(game, &card);
+	}
+	
+	return game->winner;
+}
+/*
+PSEUDOCODE:
+1) While nobody has won, the game isn't drawn and the turn limit hasn't been reached
+	2) Play the next turn
+3) Return the winner, GAME_DRAWN, or GAME_RUNNING if the game didn't finish
+*/
+
+size_t gameSnapshotSize(const Game* game)
+{
+	return arenaAllocSize(sizeof(GameSnapshot) + gameArenaSize(&game->config));
+}
+/*
+PSEUDOCODE:
+1) Add the snapshot header to the size of the game's block in its arena
+*/
+
+GameSnapshot* createGameSnapshot(Arena* arena, const Game* game)
+{
+	GameSnapshot* snapshot;
+	
+	if (game->shoe != NULL) {
+		fprintf(stderr, "Error: Games that use a shoe cannot be snapshotted\n");
+		exit(1);
+	}
+	
+	snapshot = (GameSnapshot*)arenaAlloc(arena, sizeof(GameSnapshot) + gameArenaSize(&game->config));
+	snapshot->game = game;
+	snapshot->size = gameArenaSize(&game->config); //the game is the first allocation of its block, its decks follow
+	saveGameSnapshot(snapshot, game);
+	
+	return snapshot;
+}
+/*
+PSEUDOCODE:
+1) Throw an error if the game uses a shoe, as its hands aren't in the arena
+2) Allocate the snapshot and room for the game's whole block from the arena
+3) Remember the game and the size of its block
+4) Save the game's current state and return the snapshot
+*/
+
+void saveGameSnapshot(GameSnapshot* snapshot, const Game* game)
+{
+	if (snapshot->game != game) {
+		fprintf(stderr, "Error: Snapshot belongs to another game\n");
+		exit(1);
+	}
+	
+	memcpy(snapshot->state, game, snapshot->size);
+}
+/*
+PSEUDOCODE:
+1) Throw an error if the snapshot was made for another game
+2) Copy the game's block into the snapshot
+*/
+
+void restoreGameSnapshot(Game* game, const GameSnapshot* snapshot)
+{
+	struct ReplayWriter* recorder;
+	
+	if (snapshot->game != game) {
+		fprintf(stderr, "Error: Snapshot belongs to another game\n");
+		exit(1);
+	}
+	
+	recorder = game->recorder;
+	memcpy(game, snapshot->state, snapshot->size);
+	game->recorder = recorder;
+}
+/*
+PSEUDOCODE:
+1) Throw an error if the snapshot was made for another game
+2) Copy the snapshot back over the game's block, keeping the game's current replay log
+*/
@@ -0,0 +1,310 @@
+/**
+ * @file Game.h
+ * @brief Header file for the silent game engine
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the game rules without any input or output, so that
+ * the interactive game in main.c and the batch simulator share the same
+ * logic. The rules are:
+ * - Two to MAX_PLAYERS players sit round the table
+ * - Each player gets HAND_SIZE cards, dealt in sorted order
+ * - Players take turns in seat order, playing a card that matches the top
+ *   card, chosen by their strategy (the first match by default)
+ * - If a player cannot play, they pick a card from the hidden deck
+ * - If the hidden deck is empty, played cards are shuffled and reused
+ * - First player to empty their hand wins
+ * - If the game can no longer progress, it is a draw
+ */
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdint.h>
+#include "Card.h"
+#include "CardDeck.h"
+#include "Random.h"
+#include "Arena.h"
+#include "CardShoe.h"
+#include "StateHash.h"
+#include "Strategy.h"
+
+struct ReplayWriter;
+
+#define HAND_SIZE       8  /**< cards dealt to each player at the start */
+#define DEFAULT_PLAYERS 2  /**< players in a game unless set otherwise */
+#define MAX_PLAYERS     8  /**< most players a game can have */
+
+#define GAME_RUNNING -1  /**< winner of a game nobody has won yet */
+#define GAME_DRAWN   -2  /**< winner of a game that was stuck or going round a cycle */
+
+/**
+ * @brief What happened in a single turn
+ */
+typedef enum {
+	TURN_PLAYED,   /**< the player played a matching card */
+	TURN_PICKED,   /**< the player picked a card from the hidden deck */
+	TURN_STALLED   /**< the player could not play and the hidden deck was empty */
+} TurnAction;
+
+/**
+ * @brief Settings that stay the same for every game played with a Game
+ */
+typedef struct {
+	int numPacks;   /**< number of 52-card packs in the game */
+	int numPlayers; /**< number of players, 2 to MAX_PLAYERS */
+	int useShoe;    /**< 1 to keep the hidden cards as a CardShoe of counts */
+	unsigned char strategies[MAX_PLAYERS]; /**< StrategyId each seat plays with */
+} GameConfig;
+
+/**
+ * @brief Structure holding the full state of one game
+ *
+ * The game and its decks are allocated from one arena, sized up front so
+ * that every deck can hold every card. They are reused by every call to
+ * startGame, so no game makes a heap call after setup. The hands share
+ * one cache-aligned block of the arena, seat p's hand starting
+ * p * seatStride bytes in, with its match index and cards straight after
+ * the deck. The fields a turn uses come first, so a turn touches the
+ * game's first two cache lines, the seat's strategy, the current hand and
+ * the top of each pile.
+ *
+ * A game that uses a shoe keeps its hidden cards as counts instead, so its
+ * size doesn't depend on the number of packs. Its played deck and hands
+ * are then heap decks that grow as needed and keep their memory between
+ * games.
+ */
+typedef struct {
+	CardDeck* hiddenDeck;             /**< face down deck players pick from, NULL if the game uses a shoe */
+	CardShoe* shoe;                   /**< face down cards as counts, NULL unless the game uses a shoe */
+	CardDeck* playedDeck;             /**< face up pile, the top card must be matched */
+	unsigned char* seats;             /**< block holding every hand, NULL if the game uses a shoe */
+	size_t seatStride;                /**< bytes from one hand to the next in the block */
+	int currentPlayer;                /**< player who takes the next turn */
+	int numPlayers;                   /**< number of players, copied from the settings */
+	int winner;                       /**< winning player, GAME_RUNNING or GAME_DRAWN */
+	int turns;                        /**< number of turns taken so far */
+	int refills;                      /**< number of times the hidden deck was refilled */
+	int stalls;                       /**< number of turns where a player could do nothing */
+	struct ReplayWriter* recorder;    /**< log every game and turn is recorded to, or NULL */
+	StateHash stateHash;              /**< hash of the position, used to find stuck games */
+	Rng rng;                          /**< generator used for every shuffle in the game */
+	CardDeck* players[MAX_PLAYERS];   /**< each player's sorted, indexed hand */
+	ChooseCardFn chooseCard[MAX_PLAYERS]; /**< each seat's strategy, NULL to play the first match */
+	GameConfig config;                /**< settings the game was created with */
+	Arena* arena;                     /**< arena the game and its decks live in */
+	int ownsArena;                    /**< 1 if destroyGame should destroy the arena */
+} Game;
+
+/**
+ * @brief Saved copy of the full state of a game
+ *
+ * A game without a shoe lives in one contiguous block of its arena: the
+ * game, its decks, their cards and the hands' match indexes. A snapshot
+ * is a copy of that block, so saving and restoring it is a single memcpy
+ * and every pointer inside it stays valid. It can only be restored into
+ * the game it was taken from.
+ */
+typedef struct {
+	const Game* game;         /**< game the snapshot belongs to */
+	size_t size;              /**< bytes of game state */
+	unsigned char state[];    /**< copy of the game's block of memory */
+} GameSnapshot;
+
+/**
+ * @brief Get a player's hand
+ *
+ * Works out the hand's place in the seat block, so a turn doesn't have to
+ * load the players array.
+ *
+ * @param game Pointer to the game
+ * @param seat Seat of the player, 0 to numPlayers - 1
+ * @return Pointer to the player's hand
+ */
+static inline CardDeck* gameHand(const Game* game, int seat)
+{
+	if (game->seats != NULL) {
+		return (CardDeck*)(game->seats + (size_t)seat * game->seatStride);
+	}
+	return game->players[seat];
+}
+
+/**
+ * @brief Deal cards to each hand from the hidden deck
+ *
+ * Deals one card to each hand in turn until every hand has received
+ * cardsPerHand cards. Each card goes into its sorted position.
+ *
+ * @param hiddenDeck Pointer to the hidden deck
+ * @param hands Array of pointers to the hands
+ * @param numHands Number of hands
+ * @param cardsPerHand Number of cards to deal to each hand
+ */
+void dealHands(CardDeck* hiddenDeck, CardDeck* hands[], int numHands, int cardsPerHand);
+
+/**
+ * @brief Take one turn for a player without printing anything
+ *
+ * Plays the first card in the hand that matches the top played card.
+ * If there is none, picks the top card of the hidden deck into the hand.
+ * Games use the strategy of each seat instead, through playGameTurn.
+ *
+ * @param hand Pointer to the player's sorted hand
+ * @param hiddenDeck Pointer to the hidden deck
+ * @param playedDeck Pointer to the played deck
+ * @param card Set to the card played or picked
+ * @return What the player did
+ */
+TurnAction takeTurn(CardDeck* hand, CardDeck* hiddenDeck, CardDeck* playedDeck, Card* card);
+
+/**
+ * @brief Refill the hidden deck from the played cards without printing
+ *
+ * Moves every played card except the top one to the hidden deck and
+ * shuffles it lazily, so the cost doesn't grow with the number of cards.
+ * Does nothing if there is only one played card.
+ *
+ * @param hiddenDeck Pointer to the hidden deck
+ * @param playedDeck Pointer to the played deck
+ * @param rng Pointer to the game's random number generator
+ * @return 1 if the hidden deck was refilled, 0 otherwise
+ */
+int refillFromPlayed(CardDeck* hiddenDeck, CardDeck* playedDeck, Rng* rng);
+
+/**
+ * @brief Fill in the default settings for a game
+ *
+ * @param config Pointer to the settings to fill in
+ * @param numPacks Number of 52-card packs to play with
+ */
+void initGameConfig(GameConfig* config, int numPacks);
+
+/**
+ * @brief Get the fewest packs that deal every hand and a first card
+ *
+ * @param numPlayers Number of players
+ * @return Smallest number of packs a game with that many players needs
+ */
+int minPacksForPlayers(int numPlayers);
+
+/**
+ * @brief Get the arena size needed for a game
+ *
+ * @param config Pointer to the game's settings
+ * @return Bytes createGameInArena allocates from the arena
+ */
+size_t gameArenaSize(const GameConfig* config);
+
+/**
+ * @brief Create a game in its own arena
+ *
+ * @param config Pointer to the game's settings
+ * @return Pointer to the new game, ready for startGame
+ */
+Game* createGame(const GameConfig* config);
+
+/**
+ * @brief Create a game inside an existing arena
+ *
+ * Allocates the game and its decks from the arena, which must have at
+ * least gameArenaSize(config) bytes free. Throws an error if the number
+ * of players is out of range, there are too few packs to deal to them
+ * or a seat has an unknown strategy. The game must still be passed to
+ * destroyGame before the arena is reset or destroyed, to free any heap
+ * decks of a game that uses a shoe.
+ *
+ * @param arena Pointer to the arena
+ * @param config Pointer to the game's settings
+ * @return Pointer to the new game, ready for startGame
+ */
+Game* createGameInArena(Arena* arena, const GameConfig* config);
+
+/**
+ * @brief Destroy a game
+ *
+ * Frees any heap decks, and the game's arena if createGame made it.
+ * A game made with createGameInArena is otherwise left for its arena
+ * to free.
+ *
+ * @param game Pointer to the game to destroy
+ */
+void destroyGame(Game* game);
+
+/**
+ * @brief Set up a new game from a seed
+ *
+ * Empties every deck, fills and shuffles the hidden deck or shoe, deals
+ * the hands and turns over the first card. The same seed always gives
+ * the same game.
+ *
+ * @param game Pointer to the game
+ * @param seed Seed for the game's random number generator
+ */
+void startGame(Game* game, uint64_t seed);
+
+/**
+ * @brief Play the next turn of a game
+ *
+ * Refills the hidden deck if it is empty, takes the current player's
+ * turn with their strategy, checks for a winner and moves on to the next
+ * player. A game where every player in a row could do nothing, or that
+ * comes back to a position with no random choice in between, ends as
+ * GAME_DRAWN.
+ *
+ * @param game Pointer to the game, which must not be over
+ * @param card Set to the card played or picked
+ * @return What the player did
+ */
+TurnAction playGameTurn(Game* game, Card* card);
+
+/**
+ * @brief Play a game until someone wins, it is drawn or the turn limit is reached
+ *
+ * @param game Pointer to a started game
+ * @param maxTurns Turn limit, so a game that cannot finish still ends
+ * @return The winning player, GAME_DRAWN, or GAME_RUNNING if the limit was reached first
+ */
+int playGame(Game* game, int maxTurns);
+
+/**
+ * @brief Get the arena size needed for a snapshot of a game
+ *
+ * @param game Pointer to the game
+ * @return Bytes createGameSnapshot allocates from the arena
+ */
+size_t gameSnapshotSize(const Game* game);
+
+/**
+ * @brief Create a snapshot of a game inside an arena
+ *
+ * The snapshot is one allocation of gameSnapshotSize(game) bytes and
+ * holds the game's state when it was created. Only games without a shoe
+ * can be snapshotted, as a shoe game's hands grow on the heap.
+ *
+ * @param arena Pointer to the arena
+ * @param game Pointer to the game
+ * @return Pointer to the new snapshot
+ */
+GameSnapshot* createGameSnapshot(Arena* arena, const Game* game);
+
+/**
+ * @brief Save the current state of a game into its snapshot
+ *
+ * @param snapshot Pointer to a snapshot created for the game
+ * @param game Pointer to the game
+ */
+void saveGameSnapshot(GameSnapshot* snapshot, const Game* game);
+
+/**
+ * @brief Put a game back into the state saved in a snapshot
+ *
+ * Restores every deck, the turn, the counters and the random number
+ * generator, so the game plays on exactly as it did from that point.
+ * The game keeps its current replay log.
+ *
+ * @param game Pointer to the game the snapshot was taken of
+ * @param snapshot Pointer to the snapshot
+ */
+void restoreGameSnapshot(Game* game, const GameSnapshot* snapshot);
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file Instrument.c
+ * @brief Implementation of the optional hot path instrumentation
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the counters, timers and report. It compiles to
+ * nothing unless CARDGAME_INSTRUMENT is defined.
+ */
+
+#include "Instrument.h"
+
+#ifdef CARDGAME_INSTRUMENT
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <windows.h>
+#define ATOMIC_ADD(target, value) InterlockedExchangeAdd64((volatile LONG64*)(target), (value))
+#else
+#define ATOMIC_ADD(target, value) __atomic_fetch_add((target), (value), __ATOMIC_RELAXED)
+#endif
+
+static const char* counterNames[NUM_INSTRUMENT_COUNTERS] = {
+	"deck resizes",
+	"removeCardAtIndex shifts",
+	"sorts",
+	"insertion sort compares",
+	"shuffleDeck calls",
+	"shuffleDeckLazy calls",
+	"refills"
+};
+
+static const char* timerNames[NUM_INSTRUMENT_TIMERS] = {
+	"setup",
+	"turn",
+	"output"
+};
+
+static long long counterCalls[NUM_INSTRUMENT_COUNTERS];
+static long long counterElements[NUM_INSTRUMENT_COUNTERS];
+static long long timerCalls[NUM_INSTRUMENT_TIMERS];
+static double timerSeconds[NUM_INSTRUMENT_TIMERS];
+static struct timespec timerStarts[NUM_INSTRUMENT_TIMERS];
+
+void instrumentCount(InstrumentCounter counter, long long elements)
+{
+	ATOMIC_ADD(&counterCalls[counter], 1);
+	ATOMIC_ADD(&counterElements[counter], elements);
+}
+
+void instrumentTimerStart(InstrumentTimer timer)
+{
+	timespec_get(&timerStarts[timer], TIME_UTC);
+}
+
+void instrumentTimerStop(InstrumentTimer timer)
+{
+	struct timespec end;
+	
+	timespec_get(&end, TIME_UTC);
+	timerSeconds[timer] += (double)(end.tv_sec - timerStarts[timer].tv_sec)
+	                       + (end.tv_nsec - timerStarts[timer].tv_nsec) / 1e9;
+	timerCalls[timer]++;
+}
+/*
+PSEUDOCODE:
+1) Read the clock
+2) Add the time since the phase started to its total, and count one more run of the phase
+*/
+
+void instrumentReport(FILE* out)
+{
+	int i;
+	
+	fprintf(out, "\nInstrumentation\n");
+	fprintf(out, "%-26s %14s %16s\n", "counter", "calls", "elements");
+	for (i = 0; i < NUM_INSTRUMENT_COUNTERS; i++) {
+		fprintf(out, "%-26s %14lld %16lld\n", counterNames[i], counterCalls[i], counterElements[i]);
+	}
+	
+	fprintf(out, "%-26s %14s %16s %12s\n", "timer", "calls", "total ms", "mean us");
+	for (i = 0; i < NUM_INSTRUMENT_TIMERS; i++) {
+		fprintf(out, "%-26s %14lld %16.3f %12.3f\n", timerNames[i], timerCalls[i], timerSeconds[i] * 1e3,
+		        timerCalls[i] > 0 ? timerSeconds[i] * 1e6 / timerCalls[i] : 0.0);
+	}
+}
+
+/*
+ * atexit handler for instrumentReportAtExit.
+ */
+static void reportToStderr(void)
+{
+	instrumentReport(stderr);
+}
+
+void instrumentReportAtExit(void)
+{
+	atexit(reportToStderr);
+}
+
+void instrumentReset(void)
+{
+	memset(counterCalls, 0, sizeof(counterCalls));
+	memset(counterElements, 0, sizeof(counterElements));
+	memset(timerCalls, 0, sizeof(timerCalls));
+	memset(timerSeconds, 0, sizeof(timerSeconds));
+}
+
+#else
+
+typedef int instrumentUnused; /* ISO C doesn't allow an empty file */
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file Instrument.h
+ * @brief Header file for the optional hot path instrumentation
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains counters for the expensive deck operations and timers
+ * for the phases of the game loop. They are only compiled in when
+ * CARDGAME_INSTRUMENT is defined (the ENABLE_INSTRUMENTATION CMake option).
+ * Otherwise every INSTRUMENT_ macro expands to nothing, so the normal build
+ * pays nothing for them.
+ *
+ * Counters can be updated from any thread. Timers are meant for the
+ * interactive game loop and should only be used from one thread.
+ */
+
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <stdio.h>
+
+/**
+ * @brief Events that are counted, each with a number of elements
+ */
+typedef enum {
+	COUNT_DECK_RESIZES,     /**< card array reallocations, elements are the cards kept */
+	COUNT_REMOVE_SHIFTS,    /**< removeCardAtIndex calls, elements are the cards shifted down */
+	COUNT_SORTS,            /**< sorts by either engine, elements are the cards sorted */
+	COUNT_SORT_COMPARES,    /**< insertion sort keys, elements are the comparisons made */
+	COUNT_SHUFFLES,         /**< shuffleDeck calls, elements are the cards shuffled */
+	COUNT_LAZY_SHUFFLES,    /**< shuffleDeckLazy calls, elements are the cards left to shuffle */
+	COUNT_REFILLS,          /**< hidden deck or shoe refills, elements are the cards moved */
+	NUM_INSTRUMENT_COUNTERS
+} InstrumentCounter;
+
+/**
+ * @brief Phases of the game loop that are timed
+ */
+typedef enum {
+	TIMER_SETUP,            /**< creating, shuffling and dealing */
+	TIMER_TURN,             /**< playing a turn, with any refill, and drawing it into the render buffer */
+	TIMER_OUTPUT,           /**< writing the render buffer out */
+	NUM_INSTRUMENT_TIMERS
+} InstrumentTimer;
+
+#ifdef CARDGAME_INSTRUMENT
+
+/**
+ * @brief Count one event
+ *
+ * @param counter The event to count
+ * @param elements Number of elements the event handled
+ */
+void instrumentCount(InstrumentCounter counter, long long elements);
+
+/**
+ * @brief Start timing a phase
+ *
+ * @param timer The phase to time
+ */
+void instrumentTimerStart(InstrumentTimer timer);
+
+/**
+ * @brief Stop timing a phase and add the time to its total
+ *
+ * @param timer The phase started with instrumentTimerStart
+ */
+void instrumentTimerStop(InstrumentTimer timer);
+
+/**
+ * @brief Print every counter and timer
+ *
+ * @param out Stream to print to
+ */
+void instrumentReport(FILE* out);
+
+/**
+ * @brief Print the report to stderr when the program exits
+ */
+void instrumentReportAtExit(void);
+
+/**
+ * @brief Set every counter and timer back to 0
+ */
+void instrumentReset(void);
+
+#define INSTRUMENT_COUNT(counter, elements) instrumentCount((counter), (long long)(elements))
+#define INSTRUMENT_TIMER_START(timer) instrumentTimerStart(timer)
+#define INSTRUMENT_TIMER_STOP(timer) instrumentTimerStop(timer)
+#define INSTRUMENT_REPORT(out) instrumentReport(out)
+#define INSTRUMENT_REPORT_AT_EXIT() instrumentReportAtExit()
+#define INSTRUMENT_RESET() instrumentReset()
+
+#else
+
+#define INSTRUMENT_COUNT(counter, elements) ((void)0)
+#define INSTRUMENT_TIMER_START(timer) ((void)0)
+#define INSTRUMENT_TIMER_STOP(timer) ((void)0)
+#define INSTRUMENT_REPORT(out) ((void)0)
+#define INSTRUMENT_REPORT_AT_EXIT() ((void)0)
+#define INSTRUMENT_RESET() ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * @file MatchScan.c
+ * @brief Implementation of the vectorised match scan
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the scalar, SSE2 and AVX2 match scans and the code
+ * that picks between them. A packed card matches the target when the XOR
+ * of the two is zero in the suit bits or in the rank bits, so the vector
+ * versions XOR a block of cards with the target, mask out each field,
+ * compare with zero and take the first set bit of the movemask.
+ *
+ * The vector versions are compiled with per-function target attributes on
+ * GCC and Clang, so the rest of the program doesn't need -mavx2 and still
+ * runs on processors without it.
+ */
+
+#include <stddef.h>
+#include "MatchScan.h"
+#include "Bits.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MATCH_SCAN_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+#define SCALAR_SCAN_LIMIT 16 /* scans shorter than one SSE2 block go straight to the plain loop */
+
+/*
+ * Scans cards first to count - 1 one at a time.
+ */
+static int scanFrom(const PackedCard* cards, int first, int count, PackedCard target)
+{
+	int i;
+	
+	for (i = first; i < count; i++) {
+		if (packedCardsMatch(cards[i], target)) {
+			return i;
+		}
+	}
+	
+	return -1;
+}
+
+static int matchScanScalar(const PackedCard* cards, int count, PackedCard target)
+{
+	return scanFrom(cards, 0, count, target);
+}
+
+static MatchScanFn bestScan = matchScanScalar; /* set once by initMatchScan, before any threads start */
+
+#ifdef MATCH_SCAN_X86
+
+/*
+ * Returns a bitmask with bit i set if card i of the 16 cards matches.
+ */
+TARGET_SSE2 static int matchBlock16(const PackedCard* cards, __m128i want)
+{
+	__m128i diff, suitHits, rankHits;
+	
+	diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*)cards), want);
+	suitHits = _mm_cmpeq_epi8(_mm_and_si128(diff, _mm_set1_epi8(PACKED_SUIT_MASK)), _mm_setzero_si128());
+	rankHits = _mm_cmpeq_epi8(_mm_and_si128(diff, _mm_set1_epi8(PACKED_RANK_MASK)), _mm_setzero_si128());
+	
+	return _mm_movemask_epi8(_mm_or_si128(suitHits, rankHits));
+}
+
+TARGET_SSE2 static int matchScanSse2(const PackedCard* cards, int count, PackedCard target)
+{
+	__m128i want;
+	int i, hits;
+	
+	want = _mm_set1_epi8((char)target);
+	
+	for (i = 0; i + 16 <= count; i += 16) {
+		hits = matchBlock16(cards + i, want);
+		if (hits != 0) {
+			return i + lowestSetBit((uint64_t)hits);
+		}
+	}
+	
+	return scanFrom(cards, i, count, target);
+}
+/*
+PSEUDOCODE:
+1) Fill a vector with copies of the target
+2) For each whole block of 16 cards
+	3) If any card in the block matches, return the index of the first one
+4) Scan the cards left over one at a time
+*/
+
+TARGET_AVX2 static int matchScanAvx2(const PackedCard* cards, int count, PackedCard target)
+{
+	__m256i want, diff, suitHits, rankHits;
+	unsigned hits;
+	int i;
+	
+	want = _mm256_set1_epi8((char)target);
+	
+	for (i = 0; i + 32 <= count; i += 32) {
+		diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(cards + i)), want);
+		suitHits = _mm256_cmpeq_epi8(_mm256_and_si256(diff, _mm256_set1_epi8(PACKED_SUIT_MASK)), _mm256_setzero_si256());
+		rankHits = _mm256_cmpeq_epi8(_mm256_and_si256(diff, _mm256_set1_epi8(PACKED_RANK_MASK)), _mm256_setzero_si256());
+		hits = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(suitHits, rankHits));
+		if (hits != 0) {
+			return i + lowestSetBit(hits);
+		}
+	}
+	
+	if (i + 16 <= count) {
+		hits = (unsigned)matchBlock16(cards + i, _mm256_castsi256_si128(want));
+		if (hits != 0) {
+			return i + lowestSetBit(hits);
+		}
+		i += 16;
+	}
+	
+	return scanFrom(cards, i, count, target);
+}
+/*
+PSEUDOCODE:
+1) Fill a vector with copies of the target
+2) For each whole block of 32 cards
+	3) If any card in the block matches, return the index of the first one
+4) If at least 16 cards are left, check them as one SSE2 block
+5) Scan the cards left over one at a time
+*/
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+/*
+ * Checks the CPUID feature bits, and for AVX2 that the operating system
+ * saves the AVX registers.
+ */
+static int processorSupports(MatchScanKind kind)
+{
+	int info[4];
+	
+	__cpuid(info, 1);
+	if (kind == MATCH_SCAN_SSE2) {
+		return (info[3] & (1 << 26)) != 0;
+	}
+	if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6) {
+		return 0; //no OSXSAVE, or the OS doesn't save the AVX registers
+	}
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return 0;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+}
+#else
+static int processorSupports(MatchScanKind kind)
+{
+	__builtin_cpu_init();
+	if (kind == MATCH_SCAN_SSE2) {
+		return __builtin_cpu_supports("sse2");
+	}
+	return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#endif
+
+MatchScanFn getMatchScan(MatchScanKind kind)
+{
+	switch (kind) {
+	case MATCH_SCAN_SCALAR:
+		return matchScanScalar;
+#ifdef MATCH_SCAN_X86
+	case MATCH_SCAN_SSE2:
+		return processorSupports(MATCH_SCAN_SSE2) ? matchScanSse2 : NULL;
+	case MATCH_SCAN_AVX2:
+		return processorSupports(MATCH_SCAN_AVX2) ? matchScanAvx2 : NULL;
+#endif
+	default:
+		return NULL;
+	}
+}
+/*
+PSEUDOCODE:
+1) The scalar scan is always available
+2) On x86, return the SSE2 or AVX2 scan if the processor supports it
+3) Otherwise return NULL
+*/
+
+const char* getMatchScanName(MatchScanKind kind)
+{
+	static const char* names[NUM_MATCH_SCANS] = { "scalar", "sse2", "avx2" };
+	
+	if (kind < 0 || kind >= NUM_MATCH_SCANS) {
+		return "unknown";
+	}
+	return names[kind];
+}
+
+void initMatchScan(void)
+{
+	MatchScanFn scan;
+	int kind;
+	
+	scan = NULL;
+	for (kind = NUM_MATCH_SCANS - 1; scan == NULL; kind--) {
+		scan = getMatchScan((MatchScanKind)kind);
+	}
+	bestScan = scan;
+}
+/*
+PSEUDOCODE:
+1) Try the scans from the fastest down until the processor supports one, the scalar scan always being supported
+2) Use that scan for every later findMatchingPacked
+*/
+
+int findMatchingPacked(const PackedCard* cards, int count, PackedCard target)
+{
+	if (count < SCALAR_SCAN_LIMIT) {
+		return scanFrom(cards, 0, count, target);
+	}
+	
+	return bestScan(cards, count, target);
+}
+/*
+PSEUDOCODE:
+1) If there are fewer cards than one vector holds, scan them one at a time
+2) Otherwise return the result of the scan initMatchScan picked
+*/
@@ -0,0 +1,75 @@
+/**
+ * @file MatchScan.h
+ * @brief Header file for the vectorised match scan
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the functions that find the first packed card in an
+ * array that matches a given card in suit or rank. Besides the plain loop
+ * there are SSE2 and AVX2 versions that test 16 and 32 cards at a time.
+ * initMatchScan picks the fastest version the processor supports. Until it
+ * is called, scans use the plain loop.
+ */
+
+#ifndef MATCHSCAN_H
+#define MATCHSCAN_H
+
+#include "Card.h"
+
+/**
+ * @brief The versions of the match scan
+ */
+typedef enum {
+	MATCH_SCAN_SCALAR,   /**< one card at a time, always available */
+	MATCH_SCAN_SSE2,     /**< 16 cards at a time */
+	MATCH_SCAN_AVX2,     /**< 32 cards at a time */
+	NUM_MATCH_SCANS
+} MatchScanKind;
+
+/**
+ * @brief A match scan function
+ *
+ * @param cards Array of packed cards to search
+ * @param count Number of cards in the array
+ * @param target Packed card to match against
+ * @return index of the first matching card, or -1 if no match found
+ */
+typedef int (*MatchScanFn)(const PackedCard* cards, int count, PackedCard target);
+
+/**
+ * @brief pick the fastest version of the scan this processor supports
+ *
+ * Call it once at startup, before any threads start, as the choice is
+ * shared by every thread without a lock.
+ */
+void initMatchScan(void);
+
+/**
+ * @brief find index of the first packed card matching the given card
+ *
+ * uses the version picked by initMatchScan, or the plain loop before it.
+ *
+ * @param array of packed cards to search
+ * @param number of cards in the array
+ * @param packed card to match against
+ * @return index of the first matching card, or -1 if no match found
+ */
+int findMatchingPacked(const PackedCard* cards, int count, PackedCard target);
+
+/**
+ * @brief get one version of the match scan
+ *
+ * @param version to get
+ * @return the scan function, or NULL if this build or processor can't run it
+ */
+MatchScanFn getMatchScan(MatchScanKind kind);
+
+/**
+ * @brief get the name of a version of the match scan
+ *
+ * @param version to name
+ * @return pointer to the name, such as "avx2"
+ */
+const char* getMatchScanName(MatchScanKind kind);
+
+#endif
@@ -0,0 +1,254 @@
+/**
+ * @file Parallel.c
+ * @brief Implementation of the multithreaded simulation driver
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the worker threads of a parallel simulation. Threads
+ * use the Win32 API on Windows and POSIX threads everywhere else.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Parallel.h"
+#include "ReplayLog.h"
+#include "Batch.h"
+#include "MatchScan.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE ThreadHandle;
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t ThreadHandle;
+#endif
+
+#define CACHE_LINE 64 /**< bytes in a cache line, workers are padded to this */
+
+/*
+ * Everything one worker thread needs. Each worker is padded to its own
+ * cache lines so that workers updating their statistics don't slow each
+ * other down.
+ */
+typedef struct {
+	Game* game;             /* the worker's own game and decks, NULL if it plays lockstep batches */
+	GameBatch* batch;       /* the worker's own batch, NULL unless it plays lockstep batches */
+	uint64_t seed;          /* seed of the whole simulation */
+	long long firstGame;    /* number of the worker's first game */
+	long long numGames;     /* number of games the worker plays */
+	SimStats stats;         /* the worker's own statistics */
+	ReplayWriter* recorder; /* the worker's own replay log, or NULL */
+	char padding[CACHE_LINE];
+} Worker;
+
+/*
+ * Thread entry point: plays the worker's range of games.
+ */
+#if defined(_WIN32)
+static DWORD WINAPI workerMain(LPVOID arg)
+#else
+static void* workerMain(void* arg)
+#endif
+{
+	Worker* worker;
+	
+	worker = (Worker*)arg;
+	if (worker->batch != NULL) {
+		simulateBatchGames(worker->batch, worker->seed, worker->firstGame, worker->numGames, &worker->stats);
+	} else {
+		simulateGames(worker->game, worker->seed, worker->firstGame, worker->numGames, &worker->stats);
+	}
+	
+	return 0;
+}
+
+int countProcessors(void)
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+	long count;
+	
+	count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 1;
+#endif
+}
+/*
+PSEUDOCODE:
+1) Ask the operating system how many processors are online
+2) Return that number, or 1 if it isn't known
+*/
+
+/*
+ * Gives each worker a replay log. The first worker writes straight to the
+ * file, and the others to temporary files that are appended once they
+ * have finished, so the games end up in order.
+ */
+static void openWorkerRecorders(Worker* workers, int numThreads, const char* recordPath)
+{
+	FILE* out;
+	int t;
+	
+	for (t = 0; t < numThreads; t++) {
+		out = (t == 0) ? fopen(recordPath, "wb") : tmpfile();
+		workers[t].recorder = (ReplayWriter*)malloc(sizeof(ReplayWriter));
+		if (out == NULL || workers[t].recorder == NULL) {
+			fprintf(stderr, "Error: Could not open the replay log\n");
+			exit(1);
+		}
+		initReplayWriter(workers[t].recorder, out);
+		if (t == 0) {
+			replayWriteHeader(workers[t].recorder);
+		}
+		workers[t].game->recorder = workers[t].recorder;
+	}
+}
+
+/*
+ * Finishes every worker's replay log and appends the temporary ones to
+ * the file in worker order.
+ */
+static void closeWorkerRecorders(Worker* workers, int numThreads)
+{
+	unsigned char block[REPLAY_BUFFER_SIZE];
+	FILE* out;
+	FILE* part;
+	size_t count;
+	int t;
+	
+	out = workers[0].recorder->out;
+	for (t = 0; t < numThreads; t++) {
+		finishReplayWriter(workers[t].recorder);
+		if (t > 0) {
+			part = workers[t].recorder->out;
+			rewind(part);
+			while ((count = fread(block, 1, sizeof(block), part)) > 0) {
+				if (fwrite(block, 1, count, out) != count) {
+					fprintf(stderr, "Error: Could not write the replay log\n");
+					exit(1);
+				}
+			}
+			fclose(part); //also deletes the temporary file
+		}
+	}
+	
+	fclose(out);
+	for (t = 0; t < numThreads; t++) {
+		free(workers[t].recorder);
+	}
+}
+
+/*
+ * Plays a simulation on several threads, with a Game per worker or, if
+ * batched is 1, in lockstep batches.
+ */
+static void runWorkers(long long numGames, uint64_t seed, const GameConfig* config, int numThreads, int batched,
+                       const char* recordPath, SimStats* stats)
+{
+	Worker* workers;
+	ThreadHandle* threads;
+	long long perThread, extra, next;
+	int t;
+	
+	if (numThreads < 1) {
+		numThreads = 1;
+	}
+	if (numThreads > numGames) {
+		numThreads = numGames > 0 ? (int)numGames : 1;
+	}
+	
+	workers = (Worker*)malloc((size_t)numThreads * sizeof(Worker));
+	threads = (ThreadHandle*)malloc((size_t)numThreads * sizeof(ThreadHandle));
+	if (workers == NULL || threads == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	
+	initMatchScan(); //before any worker scans
+	perThread = numGames / numThreads;
+	extra = numGames % numThreads;
+	next = 0;
+	
+	for (t = 0; t < numThreads; t++) {
+		workers[t].game = batched ? NULL : createGame(config);
+		workers[t].batch = batched ? createGameBatch(config) : NULL;
+		workers[t].seed = seed;
+		workers[t].firstGame = next;
+		workers[t].numGames = perThread + (t < extra ? 1 : 0);
+		initSimStats(&workers[t].stats);
+		workers[t].recorder = NULL;
+		next += workers[t].numGames;
+	}
+	
+	if (recordPath != NULL) {
+		openWorkerRecorders(workers, numThreads, recordPath);
+	}
+	
+	for (t = 1; t < numThreads; t++) {
+#if defined(_WIN32)
+		threads[t] = CreateThread(NULL, 0, workerMain, &workers[t], 0, NULL);
+		if (threads[t] == NULL) {
+#else
+		if (pthread_create(&threads[t], NULL, workerMain, &workers[t]) != 0) {
+#endif
+			fprintf(stderr, "Error: Could not start worker thread\n");
+			exit(1);
+		}
+	}
+	
+	workerMain(&workers[0]); //the calling thread does the first share itself
+	
+	initSimStats(stats);
+	for (t = 0; t < numThreads; t++) {
+		if (t > 0) {
+#if defined(_WIN32)
+			WaitForSingleObject(threads[t], INFINITE);
+			CloseHandle(threads[t]);
+#else
+			pthread_join(threads[t], NULL);
+#endif
+		}
+		mergeSimStats(stats, &workers[t].stats);
+	}
+	
+	if (recordPath != NULL) {
+		closeWorkerRecorders(workers, numThreads);
+	}
+	for (t = 0; t < numThreads; t++) {
+		destroyGame(workers[t].game);
+		destroyGameBatch(workers[t].batch);
+	}
+	
+	free(threads);
+	free(workers);
+}
+/*
+PSEUDOCODE:
+1) Use at least one thread, and no more threads than games
+2) Allocate a worker for each thread, throwing an error if this fails, and pick the match scan
+3) Give each worker its own game or batch and an equal, contiguous range of the games
+	and, if recording, its own replay log
+4) Start a thread for every worker except the first
+5) Play the first worker's games on the calling thread
+6) Loop over the workers in order
+	7) Wait for the worker's thread to finish
+	8) Merge its statistics into the total
+9) If recording, join the workers' replay logs into the file in order
+10) Destroy the workers' games and batches and free the workers
+*/
+
+void runParallelSimulation(long long numGames, uint64_t seed, const GameConfig* config, int numThreads,
+                           const char* recordPath, SimStats* stats)
+{
+	runWorkers(numGames, seed, config, numThreads, 0, recordPath, stats);
+}
+
+void runParallelBatchSimulation(long long numGames, uint64_t seed, const GameConfig* config, int numThreads,
+                                SimStats* stats)
+{
+	runWorkers(numGames, seed, config, numThreads, 1, NULL, stats);
+}
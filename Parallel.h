@@ -0,0 +1,58 @@
+/**
+ * @file Parallel.h
+ * @brief Header file for the multithreaded simulation driver
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the functions that split a simulation across worker
+ * threads. Each worker owns its own Game, so the workers share no mutable
+ * state, and their statistics are merged once they have all finished.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stdint.h>
+#include "Simulator.h"
+
+/**
+ * @brief Get the number of processors available to run threads on
+ *
+ * @return Number of online processors, at least 1
+ */
+int countProcessors(void);
+
+/**
+ * @brief Play a whole simulation on several threads
+ *
+ * Game g always uses the seed simGameSeed(seed, g), and the games are
+ * split into one contiguous range per thread, so the statistics are the
+ * same for a given seed whatever the number of threads.
+ *
+ * @param numGames Number of games to play
+ * @param seed Seed of the whole simulation
+ * @param config Pointer to the settings of each game
+ * @param numThreads Number of worker threads, 1 runs on the calling thread
+ * @param recordPath File to record every game to as a replay log, in game order, or NULL
+ * @param stats Pointer to statistics to fill in
+ */
+void runParallelSimulation(long long numGames, uint64_t seed, const GameConfig* config, int numThreads,
+                           const char* recordPath, SimStats* stats);
+
+/**
+ * @brief Play a whole simulation on several threads in lockstep batches
+ *
+ * Like runParallelSimulation, but each worker plays its games with
+ * simulateBatchGames. Throws an error before starting any thread if
+ * batchSupportsConfig rejects the settings.
+ *
+ * @param numGames Number of games to play
+ * @param seed Seed of the whole simulation
+ * @param config Pointer to the settings of each game
+ * @param numThreads Number of worker threads, 1 runs on the calling thread
+ * @param stats Pointer to statistics to fill in
+ */
+void runParallelBatchSimulation(long long numGames, uint64_t seed, const GameConfig* config, int numThreads,
+                                SimStats* stats);
+
+#endif
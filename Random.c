@@ -0,0 +1,100 @@
+/**
+ * @file Random.c
+ * @brief Implementation of the Rng random number generator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of xoshiro256** (Blackman and Vigna)
+ * together with the splitmix64 generator used to seed it.
+ */
+
+#include "Random.h"
+
+/*
+ * Rotates a 64-bit value left by k bits.
+ */
+static uint64_t rotl(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+/*
+ * One step of splitmix64, used to turn a single seed into a full state.
+ */
+static uint64_t splitmix64(uint64_t* x)
+{
+	uint64_t z;
+	
+	*x += 0x9E3779B97F4A7C15ULL;
+	z = *x;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+void rngSeed(Rng* rng, uint64_t seed)
+{
+	int i;
+	
+	for (i = 0; i < 4; i++) {
+		rng->s[i] = splitmix64(&seed);
+	}
+}
+/*
+PSEUDOCODE:
+1) Loop over the four words of the state
+	2) Fill each word with the next splitmix64 value of the seed
+3) splitmix64 never gives four zero words, so the state is always valid
+*/
+
+uint64_t rngNext(Rng* rng)
+{
+	uint64_t result;
+	uint64_t t;
+	
+	result = rotl(rng->s[1] * 5, 7) * 9;
+	t = rng->s[1] << 17;
+	
+	rng->s[2] ^= rng->s[0];
+	rng->s[3] ^= rng->s[1];
+	rng->s[1] ^= rng->s[2];
+	rng->s[0] ^= rng->s[3];
+	rng->s[2] ^= t;
+	rng->s[3] = rotl(rng->s[3], 45);
+	
+	return result;
+}
+/*
+PSEUDOCODE:
+1) Scramble the second word of the state to make the output
+2) Mix the four words of the state together with shifts, xors and a rotation
+3) Return the output
+*/
+
+uint32_t rngBounded(Rng* rng, uint32_t bound)
+{
+	uint64_t m;
+	uint32_t low;
+	
+	m = (rngNext(rng) >> 32) * (uint64_t)bound;
+	low = (uint32_t)m;
+	
+	if (low < bound) {
+		uint32_t threshold;
+		
+		threshold = (0U - bound) % bound; //2^32 mod bound, the size of the uneven part
+		while (low < threshold) {
+			m = (rngNext(rng) >> 32) * (uint64_t)bound;
+			low = (uint32_t)m;
+		}
+	}
+	
+	return (uint32_t)(m >> 32);
+}
+/*
+PSEUDOCODE:
+1) Multiply a random 32 bit number by the bound, the top 32 bits are the result
+2) If the bottom 32 bits fall in the uneven part of the range
+	3) Draw again until they don't, so every result is equally likely
+4) Return the top 32 bits of the product
+*/
@@ -0,0 +1,58 @@
+/**
+ * @file Random.h
+ * @brief Header file for the Rng random number generator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the definition of the Rng data type, a small seedable
+ * pseudo random number generator (xoshiro256**). Each game or simulation owns
+ * its own Rng, so there is no hidden global state: two generators can be used
+ * on different threads, and a game can be replayed exactly from its seed.
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Structure holding the state of a random number generator
+ *
+ * The state is 256 bits and must not be all zero, which rngSeed guarantees.
+ */
+typedef struct {
+	uint64_t s[4];  /**< internal generator state */
+} Rng;
+
+/**
+ * @brief seed a random number generator
+ *
+ * expands the 64-bit seed into the full generator state, so the same seed
+ * always gives the same sequence of numbers.
+ *
+ * @param rng pointer to the generator
+ * @param seed any 64-bit value
+ */
+void rngSeed(Rng* rng, uint64_t seed);
+
+/**
+ * @brief get the next 64 random bits
+ *
+ * @param rng pointer to the generator
+ * @return uniformly distributed 64-bit value
+ */
+uint64_t rngNext(Rng* rng);
+
+/**
+ * @brief get a random number in the range 0 to bound - 1
+ *
+ * uses multiply-and-reject, so every value in the range is exactly
+ * equally likely (no modulo bias).
+ *
+ * @param rng pointer to the generator
+ * @param bound exclusive upper limit, must be greater than 0
+ * @return uniformly distributed value in [0, bound)
+ */
+uint32_t rngBounded(Rng* rng, uint32_t bound);
+
+#endif
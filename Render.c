@@ -0,0 +1,207 @@
+/**
+ * @file Render.c
+ * @brief Implementation of the buffered card renderer
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of the functions for the
+ * RenderBuffer data type.
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Render.h"
+#include "CardTables.h"
+
+/*
+ * Makes sure there are at least n free bytes, flushing if there aren't.
+ */
+static void reserveRender(RenderBuffer* buffer, size_t n)
+{
+	if (buffer->used + n > buffer->size) {
+		flushRender(buffer);
+	}
+}
+
+/*
+ * Copies one CARD_WIDTH line of a card from the generated glyph table into
+ * the buffer. The caller must have reserved the space.
+ */
+static void putCardLine(RenderBuffer* buffer, PackedCard card, int line)
+{
+	memcpy(buffer->data + buffer->used, CARD_GLYPHS[card][line], CARD_WIDTH);
+	buffer->used += CARD_WIDTH;
+}
+
+void initRenderBuffer(RenderBuffer* buffer, char* data, size_t size, FILE* out, int quiet)
+{
+	buffer->out = out;
+	buffer->quiet = quiet;
+	buffer->used = 0;
+	
+	if (data != NULL) {
+		buffer->data = data;
+		buffer->size = size;
+		buffer->ownsData = 0;
+	} else {
+		buffer->data = (char*)malloc(RENDER_BUFFER_SIZE);
+		if (buffer->data == NULL) {
+			fprintf(stderr, "Error: Memory allocation failed\n");
+			exit(1);
+		}
+		buffer->size = RENDER_BUFFER_SIZE;
+		buffer->ownsData = 1;
+	}
+}
+/*
+PSEUDOCODE:
+1) Remember the output stream and whether the buffer is quiet, and start empty
+2) If the caller gave memory, use it
+3) Otherwise allocate RENDER_BUFFER_SIZE bytes, throwing an error if this fails
+*/
+
+void freeRenderBuffer(RenderBuffer* buffer)
+{
+	flushRender(buffer);
+	if (buffer->ownsData) {
+		free(buffer->data);
+	}
+	buffer->data = NULL;
+	buffer->size = 0;
+}
+/*
+PSEUDOCODE:
+1) Write out anything still in the buffer
+2) If the buffer allocated its memory, free it
+*/
+
+void flushRender(RenderBuffer* buffer)
+{
+	if (buffer->used > 0) {
+		fwrite(buffer->data, 1, buffer->used, buffer->out);
+		buffer->used = 0;
+	}
+}
+/*
+PSEUDOCODE:
+1) If there is any text in the buffer
+	2) Write all of it with a single fwrite and empty the buffer
+*/
+
+void renderText(RenderBuffer* buffer, const char* text)
+{
+	size_t length;
+	
+	if (buffer->quiet) {
+		return;
+	}
+	
+	length = strlen(text);
+	if (length > buffer->size) {
+		flushRender(buffer);
+		fwrite(text, 1, length, buffer->out); //too big to buffer, write it straight out
+		return;
+	}
+	
+	reserveRender(buffer, length);
+	memcpy(buffer->data + buffer->used, text, length);
+	buffer->used += length;
+}
+/*
+PSEUDOCODE:
+1) If the buffer is quiet, do nothing
+2) If the text is bigger than the whole buffer, flush and write the text directly
+3) Otherwise make room for the text and copy it into the buffer
+*/
+
+void renderFormat(RenderBuffer* buffer, const char* format, ...)
+{
+	va_list args;
+	int length;
+	
+	if (buffer->quiet) {
+		return;
+	}
+	
+	va_start(args, format);
+	length = vsnprintf(buffer->data + buffer->used, buffer->size - buffer->used, format, args);
+	va_end(args);
+	
+	if (length >= 0 && (size_t)length >= buffer->size - buffer->used) {
+		flushRender(buffer); //didn't fit, try again in the empty buffer
+		va_start(args, format);
+		length = vsnprintf(buffer->data, buffer->size, format, args);
+		va_end(args);
+		if ((size_t)length >= buffer->size) {
+			length = (int)buffer->size - 1; //longer than the whole buffer, so it is cut short
+		}
+	}
+	
+	if (length > 0) {
+		buffer->used += (size_t)length;
+	}
+}
+/*
+PSEUDOCODE:
+1) If the buffer is quiet, do nothing
+2) Format the text straight into the free part of the buffer
+3) If it didn't fit, flush the buffer and format it again at the start
+4) Count the formatted text as used
+*/
+
+void renderCard(RenderBuffer* buffer, PackedCard card)
+{
+	int line;
+	
+	if (buffer->quiet) {
+		return;
+	}
+	
+	reserveRender(buffer, CARD_ROWS * (CARD_WIDTH + 2));
+	for (line = 0; line < CARD_ROWS; line++) {
+		putCardLine(buffer, card, line);
+		if (line == 2 || line == 4) {
+			buffer->data[buffer->used++] = ' '; //matches the spacing of the original printCard
+		}
+		buffer->data[buffer->used++] = '\n';
+	}
+}
+/*
+PSEUDOCODE:
+1) If the buffer is quiet, do nothing
+2) Make room for a whole card
+3) Loop over the lines of the card
+	4) Copy the line from the glyph table and end it with a newline
+*/
+
+void renderCards(RenderBuffer* buffer, const PackedCard* cards, int count)
+{
+	int first, line, i, rowCount;
+	
+	if (buffer->quiet) {
+		return;
+	}
+	
+	for (first = 0; first < count; first += CARDS_PER_LINE) {
+		rowCount = count - first < CARDS_PER_LINE ? count - first : CARDS_PER_LINE;
+		reserveRender(buffer, (size_t)CARD_ROWS * ((size_t)rowCount * (CARD_WIDTH + 1) + 1));
+		
+		for (line = 0; line < CARD_ROWS; line++) {
+			for (i = 0; i < rowCount; i++) {
+				putCardLine(buffer, cards[first + i], line);
+				buffer->data[buffer->used++] = ' ';
+			}
+			buffer->data[buffer->used++] = '\n';
+		}
+	}
+}
+/*
+PSEUDOCODE:
+1) If the buffer is quiet, do nothing
+2) Loop over the cards, CARDS_PER_LINE at a time
+	3) Make room for the whole row of cards
+	4) Loop over the lines of a card
+		5) Copy that line of every card in the row, separated by spaces
+		6) End the line with a newline
+*/
@@ -0,0 +1,100 @@
+/**
+ * @file Render.h
+ * @brief Header file for the buffered card renderer
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the RenderBuffer data type and the functions that draw
+ * cards into it. Cards are copied in from fixed glyph tables, whole hands
+ * are laid out side by side, and a finished frame is written out with a
+ * single call. A quiet buffer ignores everything without formatting it.
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "Card.h"
+
+#define CARD_ROWS       7     /**< lines in a drawn card */
+#define CARD_WIDTH      9     /**< characters in each line of a drawn card */
+#define CARDS_PER_LINE  10    /**< cards drawn side by side before wrapping */
+#define RENDER_BUFFER_SIZE 65536 /**< size of a buffer made by initRenderBuffer */
+
+/**
+ * @brief Structure holding text waiting to be written
+ */
+typedef struct {
+	char* data;     /**< buffer the text is formatted into */
+	size_t size;    /**< size of the buffer in bytes */
+	size_t used;    /**< bytes of text in the buffer */
+	FILE* out;      /**< stream the text is written to */
+	int quiet;      /**< 1 to skip all formatting and output */
+	int ownsData;   /**< 1 if the buffer was allocated by initRenderBuffer */
+} RenderBuffer;
+
+/**
+ * @brief Set up a render buffer
+ *
+ * @param buffer Pointer to the render buffer
+ * @param data Memory to format into, or NULL to allocate RENDER_BUFFER_SIZE bytes
+ * @param size Size of data in bytes, at least 1024, ignored if data is NULL
+ * @param out Stream to write to
+ * @param quiet 1 to skip all formatting and output
+ */
+void initRenderBuffer(RenderBuffer* buffer, char* data, size_t size, FILE* out, int quiet);
+
+/**
+ * @brief Flush a render buffer and free its memory if it allocated it
+ *
+ * @param buffer Pointer to the render buffer
+ */
+void freeRenderBuffer(RenderBuffer* buffer);
+
+/**
+ * @brief Write everything in the buffer to its stream with one call
+ *
+ * @param buffer Pointer to the render buffer
+ */
+void flushRender(RenderBuffer* buffer);
+
+/**
+ * @brief Add text to the buffer
+ *
+ * @param buffer Pointer to the render buffer
+ * @param text Text to add
+ */
+void renderText(RenderBuffer* buffer, const char* text);
+
+/**
+ * @brief Add printf style formatted text to the buffer
+ *
+ * @param buffer Pointer to the render buffer
+ * @param format printf format string
+ */
+void renderFormat(RenderBuffer* buffer, const char* format, ...);
+
+/**
+ * @brief Draw a single card
+ *
+ * Draws the card in the same layout as printCard.
+ *
+ * @param buffer Pointer to the render buffer
+ * @param card The card to draw
+ */
+void renderCard(RenderBuffer* buffer, PackedCard card);
+
+/**
+ * @brief Draw a row of cards side by side
+ *
+ * Draws the cards next to each other, starting a new row of cards
+ * after every CARDS_PER_LINE cards.
+ *
+ * @param buffer Pointer to the render buffer
+ * @param cards Array of cards to draw
+ * @param count Number of cards
+ */
+void renderCards(RenderBuffer* buffer, const PackedCard* cards, int count);
+
+#endif
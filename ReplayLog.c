@@ -0,0 +1,269 @@
+/**
+ * @file ReplayLog.c
+ * @brief Implementation of recording and replaying games
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the replay log writer, the reader and the function
+ * that replays a recorded game up to a turn.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ReplayLog.h"
+
+#define REPLAY_MAGIC "CGRL"   /* first bytes of every replay log */
+#define REPLAY_MAGIC_SIZE 4
+#define INITIAL_TURNS 256     /* turns a record can hold before it first grows */
+
+/*
+ * Adds bytes to the buffer, writing it out first if they don't fit.
+ */
+static void writeBytes(ReplayWriter* writer, const unsigned char* bytes, size_t count)
+{
+	if (writer->used + count > REPLAY_BUFFER_SIZE) {
+		flushReplayWriter(writer);
+	}
+	memcpy(writer->buffer + writer->used, bytes, count);
+	writer->used += count;
+}
+
+/*
+ * Writes the low count bytes of value, lowest byte first.
+ */
+static void writeNumber(ReplayWriter* writer, uint64_t value, int count)
+{
+	unsigned char bytes[8];
+	int i;
+	
+	for (i = 0; i < count; i++) {
+		bytes[i] = (unsigned char)(value >> (8 * i));
+	}
+	writeBytes(writer, bytes, (size_t)count);
+}
+
+/*
+ * Reads a count byte little-endian number. Returns 0 if the stream ended.
+ */
+static int readNumber(FILE* in, uint64_t* value, int count)
+{
+	unsigned char bytes[8];
+	int i;
+	
+	if (fread(bytes, 1, (size_t)count, in) != (size_t)count) {
+		return 0;
+	}
+	
+	*value = 0;
+	for (i = 0; i < count; i++) {
+		*value |= (uint64_t)bytes[i] << (8 * i);
+	}
+	return 1;
+}
+
+void initReplayWriter(ReplayWriter* writer, FILE* out)
+{
+	writer->out = out;
+	writer->used = 0;
+	writer->inGame = 0;
+}
+
+void replayWriteHeader(ReplayWriter* writer)
+{
+	unsigned char version;
+	
+	version = REPLAY_VERSION;
+	writeBytes(writer, (const unsigned char*)REPLAY_MAGIC, REPLAY_MAGIC_SIZE);
+	writeBytes(writer, &version, 1);
+}
+
+void replayBeginGame(ReplayWriter* writer, uint64_t seed, const GameConfig* config)
+{
+	unsigned char endOfGame, flags;
+	
+	if (writer->inGame) {
+		endOfGame = REPLAY_END_OF_GAME;
+		writeBytes(writer, &endOfGame, 1);
+	}
+	
+	flags = config->useShoe ? REPLAY_FLAG_SHOE : 0;
+	writeNumber(writer, seed, 8);
+	writeNumber(writer, (uint64_t)config->numPacks, 4);
+	writeNumber(writer, (uint64_t)config->numPlayers, 1);
+	writeBytes(writer, &flags, 1);
+	writeBytes(writer, config->strategies, (size_t)config->numPlayers);
+	writer->inGame = 1;
+}
+/*
+PSEUDOCODE:
+1) If a game is being recorded, end it
+2) Write the seed, the number of packs and players, the flags and each player's strategy of the new game
+*/
+
+void replayEndGame(ReplayWriter* writer, int winner)
+{
+	unsigned char end;
+	
+	end = (winner == GAME_DRAWN) ? REPLAY_END_DRAWN : (unsigned char)(REPLAY_END_WON + winner);
+	writeBytes(writer, &end, 1);
+	writer->inGame = 0; //the game has its end byte, so the next game needn't add one
+}
+/*
+PSEUDOCODE:
+1) Work out the end byte for a draw or for the winning seat
+2) Write it, and mark the game as ended
+*/
+
+void flushReplayWriter(ReplayWriter* writer)
+{
+	if (writer->used > 0 && fwrite(writer->buffer, 1, writer->used, writer->out) != writer->used) {
+		fprintf(stderr, "Error: Could not write the replay log\n");
+		exit(1);
+	}
+	writer->used = 0;
+}
+
+void finishReplayWriter(ReplayWriter* writer)
+{
+	unsigned char endOfGame;
+	
+	if (writer->inGame) {
+		endOfGame = REPLAY_END_OF_GAME;
+		writeBytes(writer, &endOfGame, 1);
+		writer->inGame = 0;
+	}
+	flushReplayWriter(writer);
+	fflush(writer->out);
+}
+
+int replayReadHeader(FILE* in)
+{
+	unsigned char header[REPLAY_MAGIC_SIZE + 1];
+	
+	if (fread(header, 1, sizeof(header), in) != sizeof(header)) {
+		return 0;
+	}
+	
+	return memcmp(header, REPLAY_MAGIC, REPLAY_MAGIC_SIZE) == 0 && header[REPLAY_MAGIC_SIZE] == REPLAY_VERSION;
+}
+
+void initReplayRecord(ReplayRecord* record)
+{
+	memset(record, 0, sizeof(ReplayRecord));
+}
+
+int replayReadGame(FILE* in, ReplayRecord* record)
+{
+	uint64_t numPacks, numPlayers;
+	int byte, flags, p;
+	
+	if (!readNumber(in, &record->seed, 8)) {
+		return 0; //no more games
+	}
+	if (!readNumber(in, &numPacks, 4) || !readNumber(in, &numPlayers, 1) || (flags = getc(in)) == EOF) {
+		fprintf(stderr, "Error: Replay log ends in the middle of a game\n");
+		exit(1);
+	}
+	
+	initGameConfig(&record->config, (int)numPacks);
+	record->config.numPlayers = (int)numPlayers;
+	record->config.useShoe = (flags & REPLAY_FLAG_SHOE) != 0;
+	if (numPlayers < 2 || numPlayers > MAX_PLAYERS) {
+		fprintf(stderr, "Error: Replay log has a game with %d players\n", (int)numPlayers);
+		exit(1);
+	}
+	for (p = 0; p < (int)numPlayers; p++) {
+		if ((byte = getc(in)) == EOF) {
+			fprintf(stderr, "Error: Replay log ends in the middle of a game\n");
+			exit(1);
+		}
+		record->config.strategies[p] = (unsigned char)byte;
+	}
+	record->numTurns = 0;
+	
+	while ((byte = getc(in)) <= TURN_STALLED) {
+		if (byte == EOF) {
+			fprintf(stderr, "Error: Replay log ends in the middle of a game\n");
+			exit(1);
+		}
+		if (record->numTurns == record->capacity) {
+			unsigned char* actions;
+			int capacity;
+			
+			capacity = record->capacity > 0 ? record->capacity * 2 : INITIAL_TURNS;
+			actions = (unsigned char*)realloc(record->actions, (size_t)capacity);
+			if (actions == NULL) {
+				fprintf(stderr, "Error: Memory reallocation failed\n");
+				exit(1);
+			}
+			record->actions = actions;
+			record->capacity = capacity;
+		}
+		record->actions[record->numTurns++] = (unsigned char)byte;
+	}
+	
+	if (byte == REPLAY_END_OF_GAME) {
+		record->winner = GAME_RUNNING;
+	} else if (byte == REPLAY_END_DRAWN) {
+		record->winner = GAME_DRAWN;
+	} else if (byte >= REPLAY_END_WON && byte < REPLAY_END_WON + (int)numPlayers) {
+		record->winner = byte - REPLAY_END_WON;
+	} else {
+		fprintf(stderr, "Error: Replay log ends in the middle of a game\n");
+		exit(1);
+	}
+	
+	return 1;
+}
+/*
+PSEUDOCODE:
+1) Read the seed, returning 0 if the log has no more games
+2) Read the number of packs and players, the flags and each player's strategy, throwing an error if they are missing
+3) Read action bytes until a byte that isn't an action
+	4) Throw an error if the log ends first
+	5) Grow the actions array by doubling if it is full, and add the action
+6) Read how the game ended from the end byte, throwing an error if it isn't one
+7) Return 1 as a game was read
+*/
+
+void freeReplayRecord(ReplayRecord* record)
+{
+	free(record->actions);
+	initReplayRecord(record);
+}
+
+int replayToTurn(Game* game, const ReplayRecord* record, int turn)
+{
+	ReplayWriter* recorder;
+	Card card;
+	int t;
+	
+	if (game->config.numPacks != record->config.numPacks || game->config.numPlayers != record->config.numPlayers
+	    || game->config.useShoe != record->config.useShoe) {
+		fprintf(stderr, "Error: Game settings don't match the replay log\n");
+		exit(1);
+	}
+	
+	recorder = game->recorder; //replaying must not record the game again
+	game->recorder = NULL;
+	startGame(game, record->seed);
+	
+	for (t = 0; t < turn && t < record->numTurns && game->winner == GAME_RUNNING; t++) {
+		if (playGameTurn(game, &card) != (TurnAction)record->actions[t]) {
+			break;
+		}
+	}
+	
+	game->recorder = recorder;
+	return t;
+}
+/*
+PSEUDOCODE:
+1) Check the game was created with the recorded settings, throwing an error otherwise
+2) Turn off recording while replaying
+3) Start the game from the recorded seed
+4) Play turns until the requested turn, the end of the log or the end of the game
+	5) Stop early if a turn doesn't do what the log says
+6) Turn recording back on and return the number of turns that matched the log
+*/
@@ -0,0 +1,182 @@
+/**
+ * @file ReplayLog.h
+ * @brief Header file for recording and replaying games
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the compact binary replay log. Every deck in a game
+ * follows from its seed, so a game is recorded as its seed, its settings
+ * and one byte for what happened in each turn. Replaying the seed
+ * rebuilds the exact state at any turn, and the recorded actions check
+ * that the game still plays the same way.
+ *
+ * File layout, with every number little-endian:
+ * - header: the 4 bytes "CGRL" and a version byte
+ * - each game: an 8-byte seed, a 4-byte number of packs, a byte with the
+ *   number of players, a flags byte (bit 0 set if the game used a shoe),
+ *   a StrategyId byte per player, one TurnAction byte per turn, and an
+ *   end byte saying how the game ended: REPLAY_END_WON plus the seat of
+ *   the winner, REPLAY_END_DRAWN, or REPLAY_END_OF_GAME for a game that
+ *   was stopped at a turn limit
+ */
+
+#ifndef REPLAYLOG_H
+#define REPLAYLOG_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "Game.h"
+
+#define REPLAY_VERSION 4             /**< version byte written after the magic */
+#define REPLAY_BUFFER_SIZE 65536     /**< bytes buffered before each write */
+#define REPLAY_END_OF_GAME 0xFF      /**< byte that ends a game stopped before it finished */
+#define REPLAY_END_DRAWN 0xFE        /**< byte that ends a drawn game */
+#define REPLAY_END_WON 0xF0          /**< byte that ends a game won by seat 0, plus the seat for the others */
+#define REPLAY_FLAG_SHOE 0x01        /**< flags bit for a game that used a shoe */
+
+/**
+ * @brief Buffered writer for a replay log
+ *
+ * Bytes are collected in the buffer and written out in large sequential
+ * blocks, so recording a turn is a store and an increment.
+ */
+typedef struct ReplayWriter {
+	FILE* out;                                /**< stream the log is written to */
+	size_t used;                              /**< bytes in the buffer */
+	int inGame;                               /**< 1 if a game has begun and not ended */
+	unsigned char buffer[REPLAY_BUFFER_SIZE]; /**< bytes not yet written */
+} ReplayWriter;
+
+/**
+ * @brief One recorded game, as read back from a log
+ */
+typedef struct {
+	uint64_t seed;            /**< seed the game was started with */
+	GameConfig config;        /**< settings the game was played with */
+	unsigned char* actions;   /**< what happened in each turn, as TurnAction values */
+	int numTurns;             /**< number of turns recorded */
+	int winner;               /**< how the game ended: the winning player, GAME_DRAWN or GAME_RUNNING */
+	int capacity;             /**< turns the actions array can hold */
+} ReplayRecord;
+
+/**
+ * @brief Set up a writer for a stream
+ *
+ * @param writer Pointer to the writer
+ * @param out Stream to write to, opened in binary mode
+ */
+void initReplayWriter(ReplayWriter* writer, FILE* out);
+
+/**
+ * @brief Write the file header
+ *
+ * Only written once at the start of a file. Logs that are appended to
+ * another one leave it out.
+ *
+ * @param writer Pointer to the writer
+ */
+void replayWriteHeader(ReplayWriter* writer);
+
+/**
+ * @brief Start recording a game, ending the previous one if needed
+ *
+ * @param writer Pointer to the writer
+ * @param seed Seed the game is started with
+ * @param config Pointer to the game's settings
+ */
+void replayBeginGame(ReplayWriter* writer, uint64_t seed, const GameConfig* config);
+
+/**
+ * @brief Write out the buffered bytes
+ *
+ * @param writer Pointer to the writer
+ */
+void flushReplayWriter(ReplayWriter* writer);
+
+/**
+ * @brief End the current game and write out everything buffered
+ *
+ * The stream is left open for the caller to close.
+ *
+ * @param writer Pointer to the writer
+ */
+void finishReplayWriter(ReplayWriter* writer);
+
+/**
+ * @brief Record what happened in one turn
+ *
+ * @param writer Pointer to the writer
+ * @param action What the player did
+ */
+static inline void replayRecordTurn(ReplayWriter* writer, TurnAction action)
+{
+	if (writer->used == REPLAY_BUFFER_SIZE) {
+		flushReplayWriter(writer);
+	}
+	writer->buffer[writer->used++] = (unsigned char)action;
+}
+
+/**
+ * @brief Record how a game ended
+ *
+ * Called by the game when a player wins or the game is drawn. A game
+ * that is stopped before either is ended as still running when the next
+ * game begins or the writer is finished.
+ *
+ * @param writer Pointer to the writer
+ * @param winner The winning player, or GAME_DRAWN
+ */
+void replayEndGame(ReplayWriter* writer, int winner);
+
+/**
+ * @brief Read and check the file header
+ *
+ * @param in Stream to read from, opened in binary mode
+ * @return 1 if the header is a replay log of this version, 0 otherwise
+ */
+int replayReadHeader(FILE* in);
+
+/**
+ * @brief Initialise an empty record
+ *
+ * @param record Pointer to the record
+ */
+void initReplayRecord(ReplayRecord* record);
+
+/**
+ * @brief Read the next game of a log
+ *
+ * Exits with an error if the log ends part way through a game.
+ *
+ * @param in Stream to read from, just after the header or a previous game
+ * @param record Pointer to the record to fill in, reusing its memory
+ * @return 1 if a game was read, 0 at the end of the log
+ */
+int replayReadGame(FILE* in, ReplayRecord* record);
+
+/**
+ * @brief Free the memory of a record
+ *
+ * @param record Pointer to the record
+ */
+void freeReplayRecord(ReplayRecord* record);
+
+/**
+ * @brief Rebuild the state of a recorded game at a given turn
+ *
+ * Starts the game from the recorded seed and plays turns silently,
+ * checking each one against the log. The game must have been created
+ * with the recorded settings. After replaying every turn, compare the
+ * game's winner with the record's to check it ended the same way.
+ *
+ * @param game Pointer to the game to replay into
+ * @param record Pointer to the recorded game
+ * @param turn Number of turns to play
+ * @return Number of turns that matched the log, which is less than turn
+ *         if the log or the game ended first, or if a turn played
+ *         differently from the log (the game is then just after that turn)
+ */
+int replayToTurn(Game* game, const ReplayRecord* record, int turn);
+
+#endif
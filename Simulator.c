@@ -0,0 +1,193 @@
+/**
+ * @file Simulator.c
+ * @brief Implementation of the headless batch simulator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the functions that play batches of seeded games and
+ * collect statistics about them.
+ */
+
+#include <string.h>
+#include "Simulator.h"
+
+uint64_t simGameSeed(uint64_t seed, long long gameNumber)
+{
+	return seed + (uint64_t)gameNumber * 0x9E3779B97F4A7C15ULL;
+}
+/*
+PSEUDOCODE:
+1) Step the simulation seed by the game number times a large odd constant
+2) rngSeed scrambles the result, so neighbouring games are unrelated
+*/
+
+void initSimStats(SimStats* stats)
+{
+	memset(stats, 0, sizeof(SimStats));
+	stats->minTurns = -1;
+}
+/*
+PSEUDOCODE:
+1) Set every count to 0
+2) Mark the shortest game as not yet known
+*/
+
+void recordResult(SimStats* stats, int numPlayers, int winner, int turns, int refills, int stalls)
+{
+	int bucket;
+	
+	stats->games++;
+	if (numPlayers > stats->numPlayers) {
+		stats->numPlayers = numPlayers;
+	}
+	if (winner >= 0) {
+		stats->wins[winner]++;
+	} else if (winner == GAME_DRAWN) {
+		stats->draws++;
+	} else {
+		stats->unfinished++;
+	}
+	
+	stats->totalTurns += turns;
+	stats->refills += refills;
+	stats->stalls += stalls;
+	
+	if (stats->minTurns < 0 || turns < stats->minTurns) {
+		stats->minTurns = turns;
+	}
+	if (turns > stats->maxTurns) {
+		stats->maxTurns = turns;
+	}
+	
+	bucket = 0;
+	while ((turns >> (bucket + 1)) != 0 && bucket < SIM_LENGTH_BUCKETS - 1) {
+		bucket++;
+	}
+	stats->lengthBuckets[bucket]++;
+}
+/*
+PSEUDOCODE:
+1) Count the game and its players, and the win for the winner, a draw or an unfinished game
+2) Add the game's turns, refills and stalls to the totals
+3) Update the shortest and longest game
+4) Find the power of two bucket the game length falls in and count it
+*/
+
+void recordGame(SimStats* stats, const Game* game)
+{
+	recordResult(stats, game->numPlayers, game->winner, game->turns, game->refills, game->stalls);
+}
+
+void mergeSimStats(SimStats* total, const SimStats* part)
+{
+	int i;
+	
+	if (part->games == 0) {
+		return;
+	}
+	
+	total->games += part->games;
+	if (part->numPlayers > total->numPlayers) {
+		total->numPlayers = part->numPlayers;
+	}
+	for (i = 0; i < MAX_PLAYERS; i++) {
+		total->wins[i] += part->wins[i];
+	}
+	total->draws += part->draws;
+	total->unfinished += part->unfinished;
+	total->totalTurns += part->totalTurns;
+	total->refills += part->refills;
+	total->stalls += part->stalls;
+	
+	if (total->minTurns < 0 || part->minTurns < total->minTurns) {
+		total->minTurns = part->minTurns;
+	}
+	if (part->maxTurns > total->maxTurns) {
+		total->maxTurns = part->maxTurns;
+	}
+	
+	for (i = 0; i < SIM_LENGTH_BUCKETS; i++) {
+		total->lengthBuckets[i] += part->lengthBuckets[i];
+	}
+}
+/*
+PSEUDOCODE:
+1) If the part has no games, there is nothing to add
+2) Add every count of the part to the total
+3) Keep the larger number of players, the shorter of the shortest games and the longer of the longest games
+*/
+
+void simulateGames(Game* game, uint64_t seed, long long firstGame, long long numGames, SimStats* stats)
+{
+	long long g;
+	
+	for (g = firstGame; g < firstGame + numGames; g++) {
+		startGame(game, simGameSeed(seed, g));
+		playGame(game, SIM_MAX_TURNS);
+		recordGame(stats, game);
+	}
+}
+/*
+PSEUDOCODE:
+1) Loop over the games to play
+	2) Start the game from its own seed
+	3) Play it until someone wins, it is drawn or the turn limit is reached
+	4) Add it to the statistics
+*/
+
+void runSimulation(long long numGames, uint64_t seed, const GameConfig* config, SimStats* stats)
+{
+	Game* game;
+	
+	initSimStats(stats);
+	game = createGame(config);
+	simulateGames(game, seed, 0, numGames, stats);
+	destroyGame(game);
+}
+/*
+PSEUDOCODE:
+1) Reset the statistics
+2) Create one game and reuse it for every game in the simulation
+3) Destroy the game
+*/
+
+void printSimStats(const SimStats* stats, FILE* out)
+{
+	int i;
+	
+	fprintf(out, "Games played:    %lld\n", stats->games);
+	if (stats->games == 0) {
+		return;
+	}
+	
+	for (i = 0; i < stats->numPlayers; i++) {
+		fprintf(out, "Player %d wins:  %lld (%.2f%%)\n", i + 1, stats->wins[i],
+		        100.0 * stats->wins[i] / stats->games);
+	}
+	fprintf(out, "Draws:           %lld (%.2f%%)\n", stats->draws,
+	        100.0 * stats->draws / stats->games);
+	fprintf(out, "Unfinished:      %lld (%.2f%%)\n", stats->unfinished,
+	        100.0 * stats->unfinished / stats->games);
+	fprintf(out, "Turns per game:  mean %.2f, min %d, max %d\n",
+	        (double)stats->totalTurns / stats->games, stats->minTurns, stats->maxTurns);
+	fprintf(out, "Refills:         %lld (%.3f per game)\n", stats->refills,
+	        (double)stats->refills / stats->games);
+	fprintf(out, "Stalled turns:   %lld (%.3f per game)\n", stats->stalls,
+	        (double)stats->stalls / stats->games);
+	
+	fprintf(out, "Game length distribution (turns):\n");
+	for (i = 0; i < SIM_LENGTH_BUCKETS; i++) {
+		if (stats->lengthBuckets[i] > 0) {
+			fprintf(out, "  %7d - %-7d %12lld (%.2f%%)\n", 1 << i, (1 << (i + 1)) - 1,
+			        stats->lengthBuckets[i], 100.0 * stats->lengthBuckets[i] / stats->games);
+		}
+	}
+}
+/*
+PSEUDOCODE:
+1) Print the number of games, and stop if there were none
+2) Print each player's wins, the draws and the unfinished games as counts and percentages
+3) Print the mean, shortest and longest game length
+4) Print the refills and stalled turns in total and per game
+5) Print each non-empty game length bucket
+*/
@@ -0,0 +1,118 @@
+/**
+ * @file Simulator.h
+ * @brief Header file for the headless batch simulator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the SimStats data type and the functions that play
+ * many seeded games with the silent engine from Game.h and collect
+ * statistics about them, without printing anything per turn.
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "Game.h"
+
+#define SIM_MAX_TURNS      100000  /**< turn limit for a single simulated game */
+#define SIM_LENGTH_BUCKETS 18      /**< game length buckets, bucket b holds lengths 2^b to 2^(b+1) - 1 */
+
+/**
+ * @brief Statistics collected over a batch of games
+ */
+typedef struct {
+	long long games;                             /**< number of games played */
+	int numPlayers;                              /**< most players seen in a game */
+	long long wins[MAX_PLAYERS];                 /**< games won by each player */
+	long long draws;                             /**< games that were stuck or going round a cycle */
+	long long unfinished;                        /**< games stopped by the turn limit */
+	long long totalTurns;                        /**< turns over all games */
+	long long refills;                           /**< hidden deck refills over all games */
+	long long stalls;                            /**< turns where the player could do nothing */
+	int minTurns;                                /**< shortest game, in turns */
+	int maxTurns;                                /**< longest game, in turns */
+	long long lengthBuckets[SIM_LENGTH_BUCKETS]; /**< distribution of game lengths */
+} SimStats;
+
+/**
+ * @brief Get the seed used for one game of a simulation
+ *
+ * Each game gets its own seed derived from the simulation seed, so a
+ * game can be replayed on its own and the results do not depend on
+ * the order the games are played in.
+ *
+ * @param seed Seed of the whole simulation
+ * @param gameNumber Number of the game within the simulation
+ * @return Seed for that game
+ */
+uint64_t simGameSeed(uint64_t seed, long long gameNumber);
+
+/**
+ * @brief Reset statistics to an empty batch
+ *
+ * @param stats Pointer to the statistics to reset
+ */
+void initSimStats(SimStats* stats);
+
+/**
+ * @brief Add the result of one game to the statistics
+ *
+ * For engines that keep their games in some other form than a Game.
+ *
+ * @param stats Pointer to the statistics
+ * @param numPlayers Number of players in the game
+ * @param winner Winning player, GAME_DRAWN, or GAME_RUNNING if the game hit the turn limit
+ * @param turns Turns the game took
+ * @param refills Number of times the hidden deck was refilled
+ * @param stalls Number of turns where a player could do nothing
+ */
+void recordResult(SimStats* stats, int numPlayers, int winner, int turns, int refills, int stalls);
+
+/**
+ * @brief Add one finished game to the statistics
+ *
+ * @param stats Pointer to the statistics
+ * @param game Pointer to a game that has finished or hit the turn limit
+ */
+void recordGame(SimStats* stats, const Game* game);
+
+/**
+ * @brief Add one batch of statistics to another
+ *
+ * @param total Pointer to the statistics to add to
+ * @param part Pointer to the statistics to add
+ */
+void mergeSimStats(SimStats* total, const SimStats* part);
+
+/**
+ * @brief Play games firstGame to firstGame + numGames - 1 of a simulation
+ *
+ * @param game Pointer to a game created with the right number of packs
+ * @param seed Seed of the whole simulation
+ * @param firstGame Number of the first game to play
+ * @param numGames Number of games to play
+ * @param stats Pointer to statistics the games are added to
+ */
+void simulateGames(Game* game, uint64_t seed, long long firstGame, long long numGames, SimStats* stats);
+
+/**
+ * @brief Play a whole simulation on the calling thread
+ *
+ * @param numGames Number of games to play
+ * @param seed Seed of the whole simulation
+ * @param config Pointer to the settings of each game
+ * @param stats Pointer to statistics to fill in
+ */
+void runSimulation(long long numGames, uint64_t seed, const GameConfig* config, SimStats* stats);
+
+/**
+ * @brief Print a summary of the statistics
+ *
+ * @param stats Pointer to the statistics to print
+ * @param out Stream to print to
+ */
+void printSimStats(const SimStats* stats, FILE* out);
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file StateHash.c
+ * @brief Implementation of the StateHash stall and cycle detector
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the implementation of the functions for the
+ * StateHash data type.
+ */
+
+#include "StateHash.h"
+
+void initStateHash(StateHash* stateHash, CardDeck* hands[], int numHands, const CardDeck* playedDeck)
+{
+	int h, i;
+	
+	stateHash->hash = 0;
+	stateHash->playedHash = 0;
+	for (h = 0; h < numHands; h++) {
+		for (i = 0; i < hands[h]->size; i++) {
+			stateHash->hash += stateHashKey(h, cardTypeOf(hands[h]->cards[i]));
+		}
+	}
+	for (i = 0; i < playedDeck->size; i++) {
+		stateHash->playedHash += stateHashKey(STATE_HASH_PLAYED, cardTypeOf(playedDeck->cards[i]));
+	}
+	stateHash->hash += stateHash->playedHash;
+	
+	stateHash->mark = 0;
+	stateHash->sinceMark = 0;
+	stateHash->window = 0; //nothing saved yet
+	stateHash->stallRun = 0;
+	stateHash->numHands = numHands;
+	stateHash->shuffled = 0;
+}
+/*
+PSEUDOCODE:
+1) Add up the keys of every card in each hand, for that player's seat
+2) Add up the keys of every played card, and add them to the hash
+3) Clear the cycle check and the run of stalled turns
+*/
+
+int stateHashCheckCycle(StateHash* stateHash, PackedCard top, int nextSeat)
+{
+	uint64_t position;
+	
+	position = stateHash->hash + stateHashKey(STATE_HASH_TOP, cardTypeOf(top)) + stateHashKey(STATE_HASH_TURN, nextSeat);
+	
+	if (stateHash->shuffled || stateHash->window == 0) {
+		stateHash->mark = position;
+		stateHash->sinceMark = 0;
+		stateHash->window = 1;
+		stateHash->shuffled = 0;
+		return 0;
+	}
+	
+	if (position == stateHash->mark) {
+		return 1;
+	}
+	
+	stateHash->sinceMark++;
+	if (stateHash->sinceMark == stateHash->window) {
+		stateHash->mark = position;
+		stateHash->sinceMark = 0;
+		stateHash->window *= 2;
+	}
+	
+	return 0;
+}
+/*
+PSEUDOCODE:
+1) Hash the position together with the top played card and the player to move
+2) If a refill shuffled cards or nothing is saved yet
+	3) Save this position and start a window of one turn
+4) If the position is the saved one, nothing random has happened since, so report a cycle
+5) Otherwise count the turn, and when the window is full save this position and double the window
+*/
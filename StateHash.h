@@ -0,0 +1,167 @@
+/**
+ * @file StateHash.h
+ * @brief Header file for the StateHash stall and cycle detector
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the definition of the StateHash data type, a
+ * Zobrist-style hash of a game position that is updated in a few steps
+ * each turn. Every card has a random 64-bit key for each place it can be
+ * (a player's hand or the played pile), and the hash is the sum of the
+ * keys of every card, so playing or picking a card adds and subtracts one
+ * or two keys whatever the number of packs.
+ *
+ * A game that can no longer progress is found in two ways:
+ * - every player in a row could do nothing, so nothing will ever change
+ * - a position came back while no random choice was made in between,
+ *   so the game will go round the same cycle for ever
+ *
+ * Positions are compared with Brent's cycle finding, which keeps one
+ * saved hash instead of a history, so a check costs the same every turn.
+ * The order of the hidden cards isn't hashed, so positions are only
+ * compared while the hidden deck holds at most one card and no refill
+ * has shuffled two or more cards since the saved hash. The rest of the
+ * time a turn only adds the card's keys and clears the saved hash.
+ */
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <stdint.h>
+#include "Card.h"
+#include "CardDeck.h"
+
+#define STATE_HASH_PLAYED 64  /**< place number of the played pile, above any seat */
+#define STATE_HASH_TOP    65  /**< place number of the top played card, added when positions are compared */
+#define STATE_HASH_TURN   66  /**< place number of the player to move, keyed by seat */
+
+/**
+ * @brief Structure holding the hash of a position and the cycle check
+ */
+typedef struct {
+	uint64_t hash;        /** sum of the keys of every card in a hand or on the pile */
+	uint64_t playedHash;  /** part of the hash from the played pile */
+	uint64_t mark;        /** position saved by the cycle check */
+	int sinceMark;        /** turns since the position was saved */
+	int window;           /** turns before the saved position moves on, a power of two */
+	int stallRun;         /** turns in a row where the player could do nothing */
+	int numHands;         /** number of players */
+	int shuffled;         /** 1 if a refill shuffled two or more cards this turn */
+} StateHash;
+
+/**
+ * @brief get the key of a card in a place
+ *
+ * mixes the place and card number with two multiply and shift rounds, so
+ * the keys need no table and are the same in every game and on every
+ * thread.
+ *
+ * @param place seat number, or STATE_HASH_PLAYED, STATE_HASH_TOP or STATE_HASH_TURN
+ * @param type card number from cardTypeOf, or the seat for STATE_HASH_TURN
+ * @return random looking 64-bit key
+ */
+static inline uint64_t stateHashKey(int place, int type)
+{
+	uint64_t z;
+	
+	z = ((uint64_t)place * NUM_CARD_TYPES + (uint64_t)type + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 32)) * 0xD6E8FEB86659FD93ULL;
+	return z ^ (z >> 32);
+}
+
+/**
+ * @brief hash a freshly dealt position
+ *
+ * @param pointer to the hash
+ * @param array of pointers to the players' hands
+ * @param number of players
+ * @param pointer to the played deck
+ */
+void initStateHash(StateHash* stateHash, CardDeck* hands[], int numHands, const CardDeck* playedDeck);
+
+/**
+ * @brief update the hash for a card played from a hand
+ *
+ * @param pointer to the hash
+ * @param seat of the player
+ * @param card played
+ */
+static inline void hashPlayedCard(StateHash* stateHash, int seat, PackedCard card)
+{
+	uint64_t pileKey;
+	
+	pileKey = stateHashKey(STATE_HASH_PLAYED, cardTypeOf(card));
+	stateHash->playedHash += pileKey;
+	stateHash->hash += pileKey - stateHashKey(seat, cardTypeOf(card));
+}
+
+/**
+ * @brief update the hash for a card picked into a hand
+ *
+ * @param pointer to the hash
+ * @param seat of the player
+ * @param card picked
+ */
+static inline void hashPickedCard(StateHash* stateHash, int seat, PackedCard card)
+{
+	stateHash->hash += stateHashKey(seat, cardTypeOf(card));
+}
+
+/**
+ * @brief update the hash for the played pile being moved to the hidden deck
+ *
+ * @param pointer to the hash
+ * @param top played card, which stays on the pile
+ * @param number of cards moved, every played card but the top one
+ */
+static inline void hashRefill(StateHash* stateHash, PackedCard top, int movedCards)
+{
+	stateHash->hash -= stateHash->playedHash;
+	stateHash->playedHash = stateHashKey(STATE_HASH_PLAYED, cardTypeOf(top));
+	stateHash->hash += stateHash->playedHash;
+	if (movedCards >= 2) {
+		stateHash->shuffled = 1; //the order they come back in is random
+	}
+}
+
+/**
+ * @brief compare the position with the one saved by the cycle check
+ *
+ * the slow part of stateHashEndTurn, only used while the hidden deck
+ * holds at most one card.
+ *
+ * @param pointer to the hash
+ * @param top played card
+ * @param seat of the player who moves next
+ * @return 1 if the position came back with no random choice in between, 0 otherwise
+ */
+int stateHashCheckCycle(StateHash* stateHash, PackedCard top, int nextSeat);
+
+/**
+ * @brief finish a turn and check whether the game can still progress
+ *
+ * @param pointer to the hash
+ * @param 1 if the player could do nothing this turn
+ * @param top played card
+ * @param seat of the player who moves next
+ * @param number of cards left to pick from
+ * @return 1 if the game is stuck or going round a cycle, 0 otherwise
+ */
+static inline int stateHashEndTurn(StateHash* stateHash, int stalled, PackedCard top, int nextSeat, int hiddenCards)
+{
+	if (!stalled && hiddenCards > 1) {
+		stateHash->stallRun = 0;
+		stateHash->window = 0; //the hidden order matters, so nothing saved can come back
+		stateHash->shuffled = 0;
+		return 0;
+	}
+	
+	stateHash->stallRun = stalled ? stateHash->stallRun + 1 : 0;
+	if (stateHash->stallRun >= stateHash->numHands) {
+		return 1; //every player in a row could do nothing
+	}
+	
+	return hiddenCards <= 1 && stateHashCheckCycle(stateHash, top, nextSeat);
+}
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file Strategy.c
+ * @brief Implementation of the player strategies
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the choosers for each strategy. Each one walks the
+ * set bits of the playable mask, which never has more than 16 bits as a
+ * card matches 13 cards of its suit and 3 of its rank.
+ */
+
+#include <string.h>
+#include "Strategy.h"
+#include "CardTables.h"
+#include "Bits.h"
+
+static const char* const STRATEGY_NAMES[NUM_STRATEGIES] = { "first", "longest-suit", "high-rank", "lookahead" };
+
+/*
+ * Plays into the suit the hand holds most of, so the next top card is
+ * one the hand is likely to follow again. Ties go to the lowest card.
+ */
+static int chooseLongestSuit(const HandIndex* index, uint64_t playable)
+{
+	int type, best, bestCount, count;
+	
+	best = lowestSetBit(playable);
+	bestCount = index->suitCounts[best / 13];
+	for (playable &= playable - 1; playable != 0; playable &= playable - 1) {
+		type = lowestSetBit(playable);
+		count = index->suitCounts[type / 13];
+		if (count > bestCount) {
+			best = type;
+			bestCount = count;
+		}
+	}
+	
+	return best;
+}
+/*
+PSEUDOCODE:
+1) Start with the lowest playable card and the number of cards held in its suit
+2) Loop over the other playable cards
+	3) If the hand holds more cards of its suit, it is the best card so far
+4) Return the best card
+*/
+
+/*
+ * Gets rid of the highest ranked playable card. Ties go to the lowest suit.
+ */
+static int chooseHighRank(const HandIndex* index, uint64_t playable)
+{
+	int type, best;
+	
+	(void)index;
+	best = lowestSetBit(playable);
+	for (playable &= playable - 1; playable != 0; playable &= playable - 1) {
+		type = lowestSetBit(playable);
+		if (type % 13 > best % 13) {
+			best = type;
+		}
+	}
+	
+	return best;
+}
+/*
+PSEUDOCODE:
+1) Start with the lowest playable card
+2) Loop over the other playable cards, keeping the one with the highest rank
+3) Return it
+*/
+
+/*
+ * Looks one card ahead: plays the card the rest of the hand is least
+ * connected to, as fewer of the other cards share its suit or rank it
+ * would be the hardest one to get rid of later. Ties go to the highest
+ * rank, then the lowest card.
+ */
+static int chooseLookahead(const HandIndex* index, uint64_t playable)
+{
+	uint64_t rest;
+	int type, best, bestScore, score;
+	
+	best = -1;
+	bestScore = -1;
+	for (; playable != 0; playable &= playable - 1) {
+		type = lowestSetBit(playable);
+		rest = index->cardMask;
+		if (index->counts[type / 13][type % 13] == 1) {
+			rest &= ~((uint64_t)1 << type); //the last copy leaves the hand
+		}
+		score = (16 - countSetBits(cardsFollowing(rest, packedCardOfType(type)))) * 16 + type % 13;
+		if (score > bestScore) {
+			best = type;
+			bestScore = score;
+		}
+	}
+	
+	return best;
+}
+/*
+PSEUDOCODE:
+1) Loop over the playable cards
+	2) Work out the hand left after playing the card
+	3) Count the cards left that share its suit or rank, scoring fewer higher, and use the rank to break ties
+	4) Keep the card with the highest score
+5) Return the best card
+*/
+
+ChooseCardFn strategyChooser(StrategyId id)
+{
+	switch (id) {
+	case STRATEGY_LONGEST_SUIT:
+		return chooseLongestSuit;
+	case STRATEGY_HIGH_RANK:
+		return chooseHighRank;
+	case STRATEGY_LOOKAHEAD:
+		return chooseLookahead;
+	default:
+		return NULL; //the engine plays the first match itself
+	}
+}
+/*
+PSEUDOCODE:
+1) Return the chooser function of the strategy
+2) Return NULL for the first match strategy, or an unknown one
+*/
+
+const char* strategyName(StrategyId id)
+{
+	if ((unsigned)id >= NUM_STRATEGIES) {
+		return "unknown";
+	}
+	return STRATEGY_NAMES[id];
+}
+
+int parseStrategy(const char* name)
+{
+	int id;
+	
+	for (id = 0; id < NUM_STRATEGIES; id++) {
+		if (strcmp(name, STRATEGY_NAMES[id]) == 0) {
+			return id;
+		}
+	}
+	return -1;
+}
+/*
+PSEUDOCODE:
+1) Loop over the strategies
+	2) If the name matches, return the strategy
+3) Return -1 as no strategy has that name
+*/
+
+int parseStrategyList(const char* list, int ids[], int maxIds)
+{
+	char name[32];
+	const char* end;
+	size_t length;
+	int count;
+	
+	count = 0;
+	while (*list != '\0') {
+		end = strchr(list, ',');
+		length = (end != NULL) ? (size_t)(end - list) : strlen(list);
+		if (count == maxIds || length >= sizeof(name)) {
+			return -1;
+		}
+		memcpy(name, list, length);
+		name[length] = '\0';
+		if ((ids[count] = parseStrategy(name)) < 0) {
+			return -1;
+		}
+		count++;
+		list += length + (end != NULL ? 1 : 0);
+	}
+	
+	return count;
+}
+/*
+PSEUDOCODE:
+1) Loop over the names in the list, up to each comma
+	2) Return -1 if the array is full or the name is too long to be a strategy
+	3) Look the name up, returning -1 if there is no such strategy
+	4) Add the strategy to the array and move past the comma
+5) Return the number of strategies read
+*/
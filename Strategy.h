@@ -0,0 +1,78 @@
+/**
+ * @file Strategy.h
+ * @brief Header file for the player strategies
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains the strategies a player can use to choose which of
+ * their matching cards to play. A strategy only decides between cards
+ * that can be played, so the rules stay in Game.c. It sees the player's
+ * HandIndex and a mask of the playable cards, with bit cardTypeOf(card)
+ * set for each, and returns the card number to play.
+ *
+ * STRATEGY_FIRST_MATCH is the original rule of playing the first match.
+ * Its chooser is NULL, so the engine keeps its direct path through
+ * findMatchingCard and the default game pays for one NULL check a turn.
+ */
+
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include <stdint.h>
+#include "CardDeck.h"
+
+/**
+ * @brief Strategies a player can use
+ */
+typedef enum {
+	STRATEGY_FIRST_MATCH,   /**< play the lowest matching card, as the hand is sorted */
+	STRATEGY_LONGEST_SUIT,  /**< play into the suit the hand holds most of, to keep being able to follow */
+	STRATEGY_HIGH_RANK,     /**< get rid of the highest ranked matching card */
+	STRATEGY_LOOKAHEAD,     /**< play the card the rest of the hand is least connected to */
+	NUM_STRATEGIES          /**< number of strategies */
+} StrategyId;
+
+/**
+ * @brief Function that chooses a card to play
+ *
+ * @param index Match index of the player's hand
+ * @param playable Mask of the cards in the hand that can be played, never 0
+ * @return Card number, from cardTypeOf, of a card in the playable mask
+ */
+typedef int (*ChooseCardFn)(const HandIndex* index, uint64_t playable);
+
+/**
+ * @brief Get the function a strategy chooses cards with
+ *
+ * @param id The strategy
+ * @return The chooser, or NULL for STRATEGY_FIRST_MATCH, which the engine plays directly
+ */
+ChooseCardFn strategyChooser(StrategyId id);
+
+/**
+ * @brief Get the name of a strategy
+ *
+ * @param id The strategy
+ * @return Name used on the command line, or "unknown"
+ */
+const char* strategyName(StrategyId id);
+
+/**
+ * @brief Find a strategy by name
+ *
+ * @param name Name used on the command line
+ * @return The strategy, or -1 if there is none with that name
+ */
+int parseStrategy(const char* name);
+
+/**
+ * @brief Read a comma separated list of strategy names
+ *
+ * @param list Names separated by commas, such as "first,lookahead"
+ * @param ids Array the strategies are written to
+ * @param maxIds Most strategies the array can hold
+ * @return Number of strategies read, or -1 if a name is unknown or there are too many
+ */
+int parseStrategyList(const char* list, int ids[], int maxIds);
+
+#endif
@@ -0,0 +1,383 @@
+/**
+ * @file benchmark.c
+ * @brief Timing benchmarks for the CardDeck operations
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a small stand-alone program that times the CardDeck
+ * operations on decks of increasing size and prints the results as a table.
+ * It is built as the benchmark target of the CMake build.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Card.h"
+#include "CardDeck.h"
+#include "Random.h"
+#include "CardRing.h"
+#include "MatchScan.h"
+
+#define MIN_BENCH_SECONDS 0.2 /**< minimum time spent timing each deck size */
+#define BATCH_CARDS 4096      /**< cards handled between clock checks, so small decks aren't timing clock() */
+
+/**
+ * @brief Time shuffleDeck on a deck of the given number of packs
+ *
+ * Shuffles the same deck repeatedly until at least MIN_BENCH_SECONDS have
+ * passed and prints the average time per shuffle and per card.
+ *
+ * @param numPacks Number of 52-card packs in the deck
+ */
+static void benchShuffle(int numPacks)
+{
+	CardDeck* deck;
+	Rng rng;
+	clock_t start;
+	double elapsed;
+	long runs;
+	
+	deck = createCardDeckWithPacks(numPacks);
+	rngSeed(&rng, 12345);
+	runs = 0;
+	start = clock();
+	
+	do {
+		int k;
+		
+		for (k = 0; k <= BATCH_CARDS / deck->size; k++) {
+			shuffleDeck(deck, &rng);
+			runs++;
+		}
+		elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (elapsed < MIN_BENCH_SECONDS);
+	
+	printf("%8d %10d %10ld %14.3f %10.2f\n", numPacks, deck->size, runs,
+	       elapsed * 1e6 / runs, elapsed * 1e9 / ((double)runs * deck->size));
+	
+	destroyCardDeck(deck);
+}
+
+/**
+ * @brief Time one sort engine on a shuffled deck of the given size
+ *
+ * Restores the same shuffled order before every sort, so each run sorts
+ * the same unsorted deck. The restore is a single memcpy and is included
+ * in the time.
+ *
+ * @param name Name printed for the sort engine
+ * @param sort The sort engine to time
+ * @param numCards Number of cards in the deck
+ */
+static void benchSort(const char* name, void (*sort)(CardDeck*), int numCards)
+{
+	CardDeck* deck;
+	PackedCard* unsorted;
+	Rng rng;
+	clock_t start;
+	double elapsed;
+	long runs;
+	
+	deck = createCardDeckWithPacks(numCards / 52 + 1);
+	rngSeed(&rng, 12345);
+	shuffleDeck(deck, &rng);
+	deck->size = numCards;
+	
+	unsorted = (PackedCard*)malloc((size_t)numCards);
+	if (unsorted == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	memcpy(unsorted, deck->cards, (size_t)numCards);
+	
+	runs = 0;
+	start = clock();
+	
+	do {
+		int k;
+		
+		for (k = 0; k <= BATCH_CARDS / numCards; k++) {
+			memcpy(deck->cards, unsorted, (size_t)numCards);
+			sort(deck);
+			runs++;
+		}
+		elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (elapsed < MIN_BENCH_SECONDS);
+	
+	printf("%-10s %10d %10ld %14.3f %10.2f\n", name, numCards, runs,
+	       elapsed * 1e6 / runs, elapsed * 1e9 / ((double)runs * numCards));
+	
+	free(unsorted);
+	destroyCardDeck(deck);
+}
+
+/**
+ * @brief Time dealing every card from the bottom of a deck and of a ring
+ *
+ * Deals a whole shoe from the bottom with removeCardAtIndex(deck, 0),
+ * which shifts every remaining card, and with ringPopBottom, which
+ * doesn't, until at least MIN_BENCH_SECONDS have passed for each, and
+ * prints the time per card for each. The full shoe is put back before
+ * every deal with a single memcpy, which is included in the time.
+ *
+ * @param numPacks Number of 52-card packs in the shoe
+ */
+static void benchBottomDeal(int numPacks)
+{
+	CardDeck* deck;
+	CardRing* ring;
+	PackedCard* shoe;
+	clock_t start;
+	double deckTime, ringTime;
+	long deckRuns, ringRuns;
+	int numCards;
+	
+	deck = createCardDeckWithPacks(numPacks);
+	ring = createCardRing(deck->size);
+	numCards = deck->size;
+	
+	shoe = (PackedCard*)malloc((size_t)numCards);
+	if (shoe == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	memcpy(shoe, deck->cards, (size_t)numCards);
+	
+	deckRuns = 0;
+	start = clock();
+	do {
+		int k;
+		
+		for (k = 0; k <= BATCH_CARDS / numCards; k++) {
+			memcpy(deck->cards, shoe, (size_t)numCards);
+			deck->size = numCards;
+			while (deck->size > 0) {
+				removeCardAtIndex(deck, 0);
+			}
+			deckRuns++;
+		}
+		deckTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (deckTime < MIN_BENCH_SECONDS);
+	
+	ringRuns = 0;
+	start = clock();
+	do {
+		int k;
+		
+		for (k = 0; k <= BATCH_CARDS / numCards; k++) {
+			memcpy(ring->cards, shoe, (size_t)numCards);
+			ring->head = 0;
+			ring->size = numCards;
+			while (ring->size > 0) {
+				ringPopBottom(ring);
+			}
+			ringRuns++;
+		}
+		ringTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (ringTime < MIN_BENCH_SECONDS);
+	
+	printf("%8d %10d %14.2f %14.2f\n", numPacks, numCards,
+	       deckTime * 1e9 / ((double)deckRuns * numCards), ringTime * 1e9 / ((double)ringRuns * numCards));
+	
+	free(shoe);
+	destroyCardRing(ring);
+	destroyCardDeck(deck);
+}
+
+/**
+ * @brief Time refilling an empty hidden pile from the played pile
+ *
+ * Moves every card except the top one from a full played pile to an empty
+ * hidden pile, as refillFromPlayed does before it shuffles, once with
+ * CardDecks and transferCards and once with CardRings and
+ * ringSpliceAllButTop. After each refill the top card is moved across too,
+ * so the two piles swap roles and the next refill starts from a full pile
+ * again. Repeats until at least MIN_BENCH_SECONDS have passed for each
+ * and prints the time per refill.
+ *
+ * @param numPacks Number of 52-card packs in the played pile
+ */
+static void benchRefillSplice(int numPacks)
+{
+	CardDeck* decks[2];
+	CardRing* rings[2];
+	clock_t start;
+	double deckTime, ringTime;
+	long deckRuns, ringRuns;
+	int numCards, full;
+	
+	decks[0] = createCardDeckWithPacks(numPacks);
+	decks[1] = createCardDeck();
+	numCards = decks[0]->size;
+	rings[0] = createCardRing(numCards);
+	rings[1] = createCardRing(0);
+	ringAddDeck(decks[0], rings[0]);
+	
+	deckRuns = 0;
+	full = 0;
+	start = clock();
+	do {
+		int k;
+		
+		for (k = 0; k < BATCH_CARDS; k++) {
+			Card topCard;
+			
+			topCard = removeCardFromTop(decks[full]);
+			transferCards(decks[full], decks[1 - full]);
+			addCardToTop(decks[1 - full], topCard); //the full pile is now the other one
+			full = 1 - full;
+			deckRuns++;
+		}
+		deckTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (deckTime < MIN_BENCH_SECONDS);
+	
+	ringRuns = 0;
+	full = 0;
+	start = clock();
+	do {
+		int k;
+		
+		for (k = 0; k < BATCH_CARDS; k++) {
+			ringSpliceAllButTop(rings[full], rings[1 - full]);
+			ringPushTop(rings[1 - full], ringPopTop(rings[full]));
+			full = 1 - full;
+			ringRuns++;
+		}
+		ringTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (ringTime < MIN_BENCH_SECONDS);
+	
+	if (decks[full]->size != numCards || rings[full]->size != numCards) {
+		fprintf(stderr, "Error: A refill lost cards\n");
+		exit(1);
+	}
+	
+	printf("%8d %10d %14.2f %14.2f\n", numPacks, numCards,
+	       deckTime * 1e9 / deckRuns, ringTime * 1e9 / ringRuns);
+	
+	destroyCardRing(rings[0]);
+	destroyCardRing(rings[1]);
+	destroyCardDeck(decks[0]);
+	destroyCardDeck(decks[1]);
+}
+
+/**
+ * @brief Time one version of the match scan on a deck of the given size
+ *
+ * Only the last card of the deck matches, so every scan looks at every
+ * card, which is the worst case for all versions.
+ *
+ * @param kind The version of the scan to time
+ * @param numCards Number of cards in the deck
+ */
+static void benchMatchScan(MatchScanKind kind, int numCards)
+{
+	MatchScanFn scan;
+	PackedCard* cards;
+	PackedCard target;
+	clock_t start;
+	double elapsed;
+	long long found;
+	long runs;
+	int i;
+	
+	scan = getMatchScan(kind);
+	if (scan == NULL) {
+		printf("%-10s %10d %10s\n", getMatchScanName(kind), numCards, "unsupported");
+		return;
+	}
+	
+	cards = (PackedCard*)malloc((size_t)numCards);
+	if (cards == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	for (i = 0; i < numCards; i++) {
+		cards[i] = packCard((Card){ (Suit)(i % 3), (Rank)(i % 12) }); //never the suit or rank of the target
+	}
+	target = packCard((Card){ DIAMOND, ACE });
+	cards[numCards - 1] = target;
+	
+	runs = 0;
+	found = 0;
+	start = clock();
+	
+	do {
+		int k;
+		
+		for (k = 0; k <= BATCH_CARDS * 16 / numCards; k++) {
+			found += scan(cards, numCards, target);
+			runs++;
+		}
+		elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+	} while (elapsed < MIN_BENCH_SECONDS);
+	
+	if (found != (long long)runs * (numCards - 1)) {
+		fprintf(stderr, "Error: %s scan found the wrong card\n", getMatchScanName(kind));
+		exit(1);
+	}
+	
+	printf("%-10s %10d %10ld %14.3f %10.3f\n", getMatchScanName(kind), numCards, runs,
+	       elapsed * 1e6 / runs, elapsed * 1e9 / ((double)runs * numCards));
+	
+	free(cards);
+}
+
+/**
+ * @brief Main function
+ *
+ * Runs the shuffle benchmark for 1 to 100,000 packs, then compares the
+ * sort engines on player hands, a single pack and a 1,000-pack shoe,
+ * dealing from the bottom of a CardDeck and a CardRing, refilling from
+ * the played pile with each of them, and the versions of the match scan.
+ *
+ * @return 0 on successful completion
+ */
+int main(void)
+{
+	static const int sortSizes[] = { 8, 20, 52, 52000 };
+	static const int scanSizes[] = { 8, 52, 520, 5200, 52000 };
+	int numPacks;
+	int i, kind;
+	
+	printf("shuffleDeck\n");
+	printf("%8s %10s %10s %14s %10s\n", "packs", "cards", "runs", "us/shuffle", "ns/card");
+	
+	for (numPacks = 1; numPacks <= 100000; numPacks *= 10) {
+		benchShuffle(numPacks);
+	}
+	
+	printf("\nsortDeck\n");
+	printf("%-10s %10s %10s %14s %10s\n", "engine", "cards", "runs", "us/sort", "ns/card");
+	
+	for (i = 0; i < (int)(sizeof(sortSizes) / sizeof(sortSizes[0])); i++) {
+		benchSort("insertion", sortDeckInsertion, sortSizes[i]);
+		benchSort("counting", sortDeckCounting, sortSizes[i]);
+		benchSort("sortDeck", sortDeck, sortSizes[i]);
+	}
+	
+	printf("\nbottom deal (ns/card)\n");
+	printf("%8s %10s %14s %14s\n", "packs", "cards", "CardDeck", "CardRing");
+	
+	for (numPacks = 1; numPacks <= 1000; numPacks *= 10) {
+		benchBottomDeal(numPacks);
+	}
+	
+	printf("\nrefill splice (ns/refill)\n");
+	printf("%8s %10s %14s %14s\n", "packs", "cards", "CardDeck", "CardRing");
+	
+	for (numPacks = 1; numPacks <= 100000; numPacks *= 10) {
+		benchRefillSplice(numPacks);
+	}
+	
+	printf("\nfindMatchingPacked\n");
+	printf("%-10s %10s %10s %14s %10s\n", "scan", "cards", "runs", "us/scan", "ns/card");
+	
+	for (i = 0; i < (int)(sizeof(scanSizes) / sizeof(scanSizes[0])); i++) {
+		for (kind = 0; kind < NUM_MATCH_SCANS; kind++) {
+			benchMatchScan((MatchScanKind)kind, scanSizes[i]);
+		}
+	}
+	
+	return 0;
+}
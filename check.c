@@ -0,0 +1,561 @@
+/**
+ * @file check.c
+ * @brief Command line program that checks the game rules on built positions
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains checks that play positions built card by card
+ * instead of dealt from a seed, for rules that random games almost never
+ * reach, such as a game ending as a draw. It also checks that a restored
+ * snapshot plays on exactly as the game did, that replay logs record how
+ * each game ended, the CardRing operations the game doesn't use yet, and
+ * that every version of the match scan and of the lockstep batch engine
+ * finds the same cards and plays the same games as the plain one.
+ * Each check prints what went wrong, and the program returns 1 if any
+ * check failed. It is built as the check target of the CMake build and
+ * run by ctest.
+ *
+ * Usage: check
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game.h"
+#include "CardRing.h"
+#include "MatchScan.h"
+#include "ReplayLog.h"
+#include "Batch.h"
+
+#define CHECK_MAX_TURNS   1000  /**< turns before a checked game is given up */
+#define CHECK_BATCH_GAMES 20000 /**< games each version of the batch engine plays */
+#define CHECK_RING_CARDS  40    /**< cards pushed onto a ring, enough to wrap round and grow it */
+#define CHECK_SCAN_CARDS  100   /**< longest array the match scans are checked on, past three AVX2 blocks */
+#define CHECK_SCAN_TRIALS 20    /**< random arrays for each length and position of the first match */
+#define CHECK_SNAPSHOT_SEED 8   /**< seed of a game that refills twice after it is snapshotted */
+#define CHECK_SNAPSHOT_TURN 20  /**< turn the game is snapshotted after */
+
+static int failures = 0; /* number of checks that failed */
+
+/**
+ * @brief Report a check that failed
+ *
+ * @param passed 1 if the check passed
+ * @param what Description of what was checked
+ */
+static void check(int passed, const char* what)
+{
+	if (!passed) {
+		fprintf(stderr, "Failed: %s\n", what);
+		failures++;
+	}
+}
+
+/**
+ * @brief Make a card from its suit and rank
+ *
+ * @param suit Suit of the card
+ * @param rank Rank of the card
+ * @return The card
+ */
+static Card makeCard(Suit suit, Rank rank)
+{
+	Card card;
+	
+	card.suit = suit;
+	card.rank = rank;
+	return card;
+}
+
+/**
+ * @brief Replace the cards of a deck
+ *
+ * @param deck Pointer to the deck
+ * @param cards Cards to put in it, the last one on top
+ * @param numCards Number of cards
+ * @param sorted 1 to add them in order, as a hand is kept
+ */
+static void setDeck(CardDeck* deck, const Card cards[], int numCards, int sorted)
+{
+	int i;
+	
+	clearDeck(deck);
+	for (i = 0; i < numCards; i++) {
+		if (sorted) {
+			addCardSorted(deck, cards[i]);
+		} else {
+			addCardToTop(deck, cards[i]);
+		}
+	}
+}
+/*
+PSEUDOCODE:
+1) Empty the deck
+2) Add each card, in order for a hand or on top for a pile
+*/
+
+/**
+ * @brief Start a two-player game from a built position
+ *
+ * The first player moves first, as in a dealt game.
+ *
+ * @param game Pointer to a two-player, one-pack game
+ * @param first First player's hand
+ * @param numFirst Number of cards in it
+ * @param second Second player's hand
+ * @param numSecond Number of cards in it
+ * @param played Played pile, the top card last
+ * @param numPlayed Number of played cards, at least 1
+ * @param hidden Hidden deck, the card picked next last
+ * @param numHidden Number of hidden cards
+ */
+static void startPosition(Game* game, const Card first[], int numFirst, const Card second[], int numSecond,
+                          const Card played[], int numPlayed, const Card hidden[], int numHidden)
+{
+	startGame(game, 1);
+	setDeck(game->players[0], first, numFirst, 1);
+	setDeck(game->players[1], second, numSecond, 1);
+	setDeck(game->playedDeck, played, numPlayed, 0);
+	setDeck(game->hiddenDeck, hidden, numHidden, 0);
+	initStateHash(&game->stateHash, game->players, game->numPlayers, game->playedDeck);
+}
+/*
+PSEUDOCODE:
+1) Start a game to reset the turn, winner and counters
+2) Replace the dealt hands, played pile and hidden deck with the built ones
+3) Hash the built position
+*/
+
+/*
+ * Neither hand matches the top card and there is nothing to pick or
+ * refill from, so both players stall and the game is drawn after their
+ * first turns.
+ */
+static void checkStuckTable(Game* game)
+{
+	const Card first[] = { makeCard(SPADE, ACE) };
+	const Card second[] = { makeCard(CLUB, KING) };
+	const Card played[] = { makeCard(DIAMOND, FIVE) };
+	
+	startPosition(game, first, 1, second, 1, played, 1, NULL, 0);
+	check(playGame(game, CHECK_MAX_TURNS) == GAME_DRAWN, "a stuck table is drawn");
+	check(game->turns == 2 && game->stalls == 2, "a stuck table is drawn once every player has stalled");
+}
+/*
+PSEUDOCODE:
+1) Build a position where no hand matches the top card and there are no other cards
+2) Play it and check that it is drawn after both players have stalled once
+*/
+
+/*
+ * The 7 and 8 of Spades go round between the pile, the hidden deck and
+ * the hands, and each refill moves one card so nothing is shuffled. The
+ * game goes back to the same position every six turns, with stalls in
+ * between that never make a run, and the cycle check draws it after 14
+ * turns.
+ */
+static void checkLoop(Game* game)
+{
+	const Card first[] = { makeCard(HEART, TWO) };
+	const Card second[] = { makeCard(DIAMOND, THREE), makeCard(DIAMOND, FIVE) };
+	const Card played[] = { makeCard(SPADE, SEVEN), makeCard(SPADE, EIGHT) };
+	const Card hidden[] = { makeCard(DIAMOND, ACE) };
+	
+	startPosition(game, first, 1, second, 2, played, 2, hidden, 1);
+	check(playGame(game, CHECK_MAX_TURNS) == GAME_DRAWN, "a game going round a cycle is drawn");
+	check(game->turns == 14, "a cycle is drawn after 14 turns");
+	check(game->stalls < game->turns, "a cycle is drawn by the cycle check, not as a stuck table");
+}
+/*
+PSEUDOCODE:
+1) Build a position where two cards go round between the pile, the hidden deck and the hands
+2) Play it and check that the cycle check draws it after 14 turns
+*/
+
+/*
+ * Snapshots a game part way through, plays it to the end, restores the
+ * snapshot and plays it to the end again. The second run must end the
+ * same way, with the same hands and generator state. The game records
+ * to one replay log before the restore and is switched to another one
+ * just before it, which it must keep and record the same turns to.
+ */
+static void checkSnapshot(Game* game)
+{
+	static ReplayWriter logs[2];                /* only buffer, they are never written out */
+	static PackedCard hands[MAX_PLAYERS][52];   /* hands at the end of a one-pack game */
+	int handSizes[MAX_PLAYERS];
+	Arena* arena;
+	GameSnapshot* snapshot;
+	Rng rng;
+	size_t start;
+	int winner, turns, p, same;
+	
+	initReplayWriter(&logs[0], NULL);
+	initReplayWriter(&logs[1], NULL);
+	game->recorder = &logs[0];
+	startGame(game, CHECK_SNAPSHOT_SEED);
+	check(playGame(game, CHECK_SNAPSHOT_TURN) == GAME_RUNNING, "a game is still running when it is snapshotted");
+	
+	arena = createArena(gameSnapshotSize(game));
+	snapshot = createGameSnapshot(arena, game);
+	start = logs[0].used;
+	
+	winner = playGame(game, CHECK_MAX_TURNS);
+	turns = game->turns;
+	rng = game->rng;
+	for (p = 0; p < game->numPlayers; p++) {
+		handSizes[p] = game->players[p]->size;
+		memcpy(hands[p], game->players[p]->cards, (size_t)handSizes[p]);
+	}
+	
+	game->recorder = &logs[1];
+	restoreGameSnapshot(game, snapshot);
+	check(game->turns == CHECK_SNAPSHOT_TURN && game->recorder == &logs[1],
+	      "a restored game is back at the snapshot and keeps its current replay log");
+	
+	check(playGame(game, CHECK_MAX_TURNS) == winner && game->turns == turns, "a restored game ends the same way");
+	same = memcmp(&game->rng, &rng, sizeof(Rng)) == 0;
+	for (p = 0; p < game->numPlayers; p++) {
+		same = same && game->players[p]->size == handSizes[p]
+		       && memcmp(game->players[p]->cards, hands[p], (size_t)handSizes[p]) == 0;
+	}
+	check(same, "a restored game ends with the same hands and generator state");
+	check(logs[1].used == logs[0].used - start && memcmp(logs[1].buffer, logs[0].buffer + start, logs[1].used) == 0,
+	      "a restored game records the same turns");
+	
+	game->recorder = NULL;
+	destroyArena(arena);
+}
+/*
+PSEUDOCODE:
+1) Record a game to the first log and play it up to the snapshot turn
+2) Snapshot it and remember where the first log is up to
+3) Play it to the end and remember the winner, turns, generator state and hands
+4) Switch the game to the second log, restore the snapshot and check it is back at that turn and kept the second log
+5) Play it to the end again and check everything remembered came out the same
+6) Check the second log holds the same turns the first one recorded after the snapshot
+7) Stop recording and free the snapshot
+*/
+
+/*
+ * Records a game that is won, the same game stopped at a turn limit and
+ * the stuck table, which is drawn, to a replay log. Reading the log back
+ * must give each game's ending, and replaying the first two must end the
+ * same way.
+ */
+static void checkReplayEndings(Game* game)
+{
+	static ReplayWriter writer;
+	const Card first[] = { makeCard(SPADE, ACE) };
+	const Card second[] = { makeCard(CLUB, KING) };
+	const Card played[] = { makeCard(DIAMOND, FIVE) };
+	ReplayRecord record;
+	FILE* log;
+	int winner;
+	
+	log = tmpfile();
+	if (log == NULL) {
+		fprintf(stderr, "Error: Could not open a temporary file\n");
+		exit(1);
+	}
+	initReplayWriter(&writer, log);
+	replayWriteHeader(&writer);
+	game->recorder = &writer;
+	
+	startGame(game, CHECK_SNAPSHOT_SEED);
+	winner = playGame(game, CHECK_MAX_TURNS);
+	startGame(game, CHECK_SNAPSHOT_SEED);
+	playGame(game, CHECK_SNAPSHOT_TURN);
+	startPosition(game, first, 1, second, 1, played, 1, NULL, 0);
+	playGame(game, CHECK_MAX_TURNS);
+	
+	game->recorder = NULL;
+	finishReplayWriter(&writer);
+	rewind(log);
+	initReplayRecord(&record);
+	
+	check(replayReadHeader(log) && replayReadGame(log, &record) && record.winner == winner && winner >= 0,
+	      "a replay log records the winner of a game");
+	check(replayToTurn(game, &record, record.numTurns) == record.numTurns && game->winner == record.winner,
+	      "a replayed game is won by the recorded winner");
+	check(replayReadGame(log, &record) && record.winner == GAME_RUNNING && record.numTurns == CHECK_SNAPSHOT_TURN,
+	      "a replay log records a game stopped at a turn limit as still running");
+	check(replayToTurn(game, &record, record.numTurns) == record.numTurns && game->winner == GAME_RUNNING,
+	      "a replayed game stopped at a turn limit is still running");
+	check(replayReadGame(log, &record) && record.winner == GAME_DRAWN && !replayReadGame(log, &record),
+	      "a replay log records a drawn game");
+	
+	freeReplayRecord(&record);
+	fclose(log);
+}
+/*
+PSEUDOCODE:
+1) Record a game played to the end, the same game stopped at a turn limit and the stuck table to a temporary log
+2) Read the log back
+3) Check the first game has its winner and replays to the same winner
+4) Check the second game is still running and replays to a running game
+5) Check the third game is drawn and is the last in the log
+6) Free the record and close the log
+*/
+
+/**
+ * @brief Check that a ring holds the given cards
+ *
+ * @param ring Pointer to the ring
+ * @param types Card type of each card expected, from the bottom
+ * @param numCards Number of cards expected
+ * @return 1 if the ring holds exactly those cards in that order
+ */
+static int ringHolds(const CardRing* ring, const int types[], int numCards)
+{
+	int i;
+	
+	if (ring->size != numCards) {
+		return 0;
+	}
+	for (i = 0; i < numCards; i++) {
+		if (ringCardAt(ring, i) != packedCardOfType(types[i])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+/*
+PSEUDOCODE:
+1) If the ring holds a different number of cards, it doesn't match
+2) Compare each card from the bottom with the expected one
+*/
+
+/*
+ * Pushes cards onto both ends of a small ring, so it wraps round the end
+ * of its array and then grows, and takes cards off both ends. Then
+ * splices every card but the top one onto an empty ring, which swaps
+ * their arrays, and onto a ring that already holds cards, which copies
+ * them.
+ */
+static void checkRing(void)
+{
+	CardRing* source;
+	CardRing* dest;
+	int expected[CHECK_RING_CARDS];
+	int i, n;
+	
+	source = createCardRing(0);
+	for (i = 0; i < 10; i++) {
+		ringPushTop(source, packedCardOfType(i));
+	}
+	for (i = 10; i < CHECK_RING_CARDS; i++) {
+		ringPushBottom(source, packedCardOfType(i));
+	}
+	n = 0;
+	for (i = CHECK_RING_CARDS - 1; i >= 0; i--) {
+		expected[n++] = (i >= 10) ? i : 9 - i; //the bottom pushes come out reversed, then the top pushes in order
+	}
+	check(ringHolds(source, expected, n), "cards pushed onto both ends of a ring keep their order as it wraps and grows");
+	check(ringPopBottom(source) == packedCardOfType(CHECK_RING_CARDS - 1) && ringPopTop(source) == packedCardOfType(9),
+	      "cards come off both ends of a ring");
+	
+	dest = createCardRing(0);
+	ringSpliceAllButTop(source, dest);
+	check(ringHolds(dest, expected + 1, n - 3) && source->size == 1 && ringPeekTop(source) == packedCardOfType(8),
+	      "splicing onto an empty ring moves every card but the top one in order");
+	
+	ringPushTop(source, packedCardOfType(40));
+	ringPushTop(source, packedCardOfType(41));
+	ringSpliceAllButTop(source, dest);
+	expected[n - 2] = 8;
+	expected[n - 1] = 40;
+	check(ringHolds(dest, expected + 1, n - 1) && source->size == 1 && ringPeekTop(source) == packedCardOfType(41),
+	      "splicing onto a ring that holds cards puts them on top in order");
+	
+	ringSpliceAllButTop(source, dest);
+	check(dest->size == n - 1 && source->size == 1, "splicing a ring with only a top card moves nothing");
+	
+	destroyCardRing(source);
+	destroyCardRing(dest);
+}
+/*
+PSEUDOCODE:
+1) Push cards onto the top and then the bottom of a small ring, and check their order
+2) Take a card off each end and check they are the bottom and top cards
+3) Splice the ring onto an empty one and check every card but the top one moved in order
+4) Add two cards to the source, splice it onto the now full ring and check they went on top in order
+5) Splice a ring with one card and check nothing moved
+6) Destroy both rings
+*/
+
+/**
+ * @brief Pick a random card that does or doesn't match a target
+ *
+ * @param rng Pointer to the random number generator
+ * @param target Card to match against
+ * @param matching 1 for a card that matches the target, 0 for one that doesn't
+ * @return The card
+ */
+static PackedCard randomCard(Rng* rng, PackedCard target, int matching)
+{
+	PackedCard card;
+	
+	do {
+		card = packedCardOfType((int)rngBounded(rng, 52));
+	} while (packedCardsMatch(card, target) != matching);
+	
+	return card;
+}
+/*
+PSEUDOCODE:
+1) Pick random cards until one matches the target, or doesn't, as asked
+*/
+
+/*
+ * Compares every version of the match scan this processor has, and
+ * findMatchingPacked, with the plain loop on every length up to
+ * CHECK_SCAN_CARDS, so whole blocks of 16 and 32 cards, the SSE2 block
+ * after the AVX2 blocks and the cards left over are all reached. The
+ * first match is put at every position, or left out, with random cards
+ * after it, and the array starts at a random offset so the loads are
+ * not aligned.
+ */
+static void checkMatchScans(void)
+{
+	PackedCard buffer[CHECK_SCAN_CARDS + 4];
+	PackedCard* cards;
+	PackedCard target;
+	MatchScanFn scalar, scan;
+	Rng rng;
+	char what[80];
+	int kind, count, first, trial, i, same;
+	
+	rngSeed(&rng, 1);
+	scalar = getMatchScan(MATCH_SCAN_SCALAR);
+	for (kind = MATCH_SCAN_SCALAR; kind < NUM_MATCH_SCANS; kind++) {
+		scan = (kind == MATCH_SCAN_SCALAR) ? findMatchingPacked : getMatchScan((MatchScanKind)kind);
+		if (scan == NULL) {
+			continue;
+		}
+		
+		same = 1;
+		for (count = 0; count <= CHECK_SCAN_CARDS; count++) {
+			for (first = -1; first < count; first++) {
+				for (trial = 0; trial < CHECK_SCAN_TRIALS; trial++) {
+					cards = buffer + rngBounded(&rng, 4);
+					target = packedCardOfType((int)rngBounded(&rng, 52));
+					for (i = 0; i < count; i++) {
+						if (i < first || first == -1) {
+							cards[i] = randomCard(&rng, target, 0);
+						} else if (i == first) {
+							cards[i] = randomCard(&rng, target, 1);
+						} else {
+							cards[i] = packedCardOfType((int)rngBounded(&rng, 52)); //may match too
+						}
+					}
+					same = same && scalar(cards, count, target) == first && scan(cards, count, target) == first;
+				}
+			}
+		}
+		
+		snprintf(what, sizeof(what), "the %s match scan finds the same card as the plain loop",
+		         (kind == MATCH_SCAN_SCALAR) ? "chosen" : getMatchScanName((MatchScanKind)kind));
+		check(same, what);
+	}
+}
+/*
+PSEUDOCODE:
+1) Loop over the chosen scan and each vector version this processor supports
+	2) Loop over every length up to the longest checked and every position of the first match, or none
+		3) Loop over a few random arrays
+			4) Start the array at a random offset and pick a random target
+			5) Fill it with cards that don't match before the first match, a match there and random cards after
+			6) Check the plain loop and this version both find the first match
+	7) Report any version that found a different card
+*/
+
+/*
+ * Plays fewer games than a batch has lanes with the scalar steps, so the
+ * lanes that never start a game are stepped too, then plays a longer run
+ * with every version of the steps this processor has and compares the
+ * statistics with the scalar ones.
+ */
+static void checkBatch(int numPlayers)
+{
+	GameConfig config;
+	GameBatch* batch;
+	SimStats scalar, stats;
+	int kind, p;
+	long long games;
+	
+	initGameConfig(&config, 1);
+	config.numPlayers = numPlayers;
+	batch = createGameBatch(&config);
+	
+	useBatchKernels(batch, BATCH_KERNEL_SCALAR);
+	initSimStats(&stats);
+	simulateBatchGames(batch, 1, 0, BATCH_LANES / 2 - 1, &stats);
+	games = stats.draws + stats.unfinished;
+	for (p = 0; p < numPlayers; p++) {
+		games += stats.wins[p];
+	}
+	check(stats.games == BATCH_LANES / 2 - 1 && games == stats.games, "a part filled batch plays every game once");
+	
+	initSimStats(&scalar);
+	simulateBatchGames(batch, 1, 0, CHECK_BATCH_GAMES, &scalar);
+	for (kind = BATCH_KERNEL_SCALAR + 1; kind < NUM_BATCH_KERNELS; kind++) {
+		if (useBatchKernels(batch, (BatchKernelKind)kind)) {
+			initSimStats(&stats);
+			simulateBatchGames(batch, 1, 0, CHECK_BATCH_GAMES, &stats);
+			check(memcmp(&stats, &scalar, sizeof(SimStats)) == 0, "every version of the batch steps plays the same games");
+		}
+	}
+	
+	destroyGameBatch(batch);
+}
+/*
+PSEUDOCODE:
+1) Create a batch for the number of players and use the scalar steps
+2) Play fewer games than half the lanes and check that each was recorded once
+3) Play a longer run with the scalar steps
+4) Loop over the other versions of the steps this processor supports
+	5) Play the same run and check that the statistics are the same
+6) Destroy the batch
+*/
+
+/**
+ * @brief Main function
+ *
+ * Runs every check on one two-player game, then the CardRing and match
+ * scan checks and the batch engine checks for each number of players it
+ * seats, and prints the result.
+ *
+ * @return 0 if every check passed, 1 otherwise
+ */
+int main(void)
+{
+	GameConfig config;
+	Game* game;
+	int numPlayers;
+	
+	initMatchScan();
+	initGameConfig(&config, 1);
+	game = createGame(&config);
+	
+	checkStuckTable(game);
+	checkLoop(game);
+	checkSnapshot(game);
+	checkReplayEndings(game);
+	
+	destroyGame(game);
+	
+	checkRing();
+	checkMatchScans();
+	
+	for (numPlayers = 2; numPlayers <= BATCH_MAX_PLAYERS; numPlayers++) {
+		checkBatch(numPlayers);
+	}
+	
+	if (failures > 0) {
+		printf("%d check(s) failed\n", failures);
+		return 1;
+	}
+	printf("All checks passed\n");
+	return 0;
+}
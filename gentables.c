@@ -0,0 +1,178 @@
+/**
+ * @file gentables.c
+ * @brief Build-time generator for the card lookup tables
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a program that is run by the build to write
+ * CardTables.c, the tables declared in CardTables.h. Everything about a
+ * card that never changes is worked out here once, so the game only
+ * looks it up:
+ * - for every packed card, a mask of the card numbers it matches
+ * - the names of the suits and ranks
+ * - every line of every drawn card
+ *
+ * Usage: gentables output.c
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Card.h"
+#include "Render.h"
+
+static const char* const suitNames[4] = { "Club", "Spade", "Heart", "Diamond" };
+static const char* const rankNames[13] = { "Two", "Three", "Four", "Five", "Six", "Seven", "Eight",
+                                           "Nine", "Ten", "Jack", "Queen", "King", "Ace" };
+
+/* Glyphs for the corners and centre of a card, two and seven characters */
+static const char* const rankGlyphs[13] = { "2 ", "3 ", "4 ", "5 ", "6 ", "7 ", "8 ", "9 ", "10", "J ", "Q ", "K ", "A " };
+static const char* const suitGlyphs[4] = { " club  ", " spade ", " heart ", "diamond" };
+
+/*
+ * Returns 1 if the packed value is a real card, 0 for the unused values.
+ */
+static int isCard(int packed)
+{
+	return (packed & PACKED_RANK_MASK) < 13;
+}
+
+/*
+ * Writes the mask of card numbers each packed card matches.
+ */
+static void writeMatchMasks(FILE* out)
+{
+	uint64_t mask;
+	int card, other;
+	
+	fprintf(out, "const uint64_t CARD_MATCH_MASKS[PACKED_CARD_LIMIT] = {\n");
+	for (card = 0; card < PACKED_CARD_LIMIT; card++) {
+		mask = 0;
+		for (other = 0; other < NUM_CARD_TYPES && isCard(card); other++) {
+			if (packedCardsMatch((PackedCard)card, packedCardOfType(other))) {
+				mask |= (uint64_t)1 << other;
+			}
+		}
+		fprintf(out, "%s0x%013llXULL,%s", (card % 4 == 0) ? "\t" : "", (unsigned long long)mask, (card % 4 == 3) ? "\n" : " ");
+	}
+	fprintf(out, "};\n\n");
+}
+/*
+PSEUDOCODE:
+1) Loop over every packed card value
+	2) If it is a real card, set the bit of every card number that matches it in suit or rank
+	3) Write the mask, four to a line
+*/
+
+/*
+ * Writes one line of a drawn card, exactly CARD_WIDTH characters.
+ */
+static void drawCardLine(char* line, int card, int row)
+{
+	const char* rank;
+	const char* suit;
+	
+	rank = isCard(card) ? rankGlyphs[card & PACKED_RANK_MASK] : "? ";
+	suit = suitGlyphs[card >> PACKED_SUIT_SHIFT];
+	
+	switch (row) {
+	case 0:
+		memcpy(line, " _______ ", CARD_WIDTH);
+		break;
+	case 1:
+		memcpy(line, "|       |", CARD_WIDTH);
+		memcpy(line + 1, rank, 2); //rank in top corner
+		break;
+	case 3:
+		line[0] = '|';
+		memcpy(line + 1, suit, 7); //suit in the centre
+		line[8] = '|';
+		break;
+	case 5:
+		memcpy(line, "|       |", CARD_WIDTH);
+		memcpy(line + 6, rank, 2); //rank in bottom corner
+		break;
+	case 6:
+		memcpy(line, " ------- ", CARD_WIDTH);
+		break;
+	default:
+		memcpy(line, "|       |", CARD_WIDTH);
+		break;
+	}
+}
+
+/*
+ * Writes every line of every drawn card.
+ */
+static void writeCardGlyphs(FILE* out)
+{
+	char line[CARD_WIDTH];
+	int card, row;
+	
+	fprintf(out, "const char CARD_GLYPHS[PACKED_CARD_LIMIT][CARD_ROWS][CARD_WIDTH + 1] = {\n");
+	for (card = 0; card < PACKED_CARD_LIMIT; card++) {
+		fprintf(out, "\t{ ");
+		for (row = 0; row < CARD_ROWS; row++) {
+			drawCardLine(line, card, row);
+			fprintf(out, "\"%.*s\"%s", CARD_WIDTH, line, (row < CARD_ROWS - 1) ? ", " : " },\n");
+		}
+	}
+	fprintf(out, "};\n");
+}
+/*
+PSEUDOCODE:
+1) Loop over every packed card value
+	2) Draw each line of the card from the rank and suit glyphs and write it as a string
+*/
+
+/*
+ * Writes a table of names.
+ */
+static void writeNames(FILE* out, const char* declaration, const char* const* names, int count)
+{
+	int i;
+	
+	fprintf(out, "%s = {", declaration);
+	for (i = 0; i < count; i++) {
+		fprintf(out, " \"%s\"%s", names[i], (i < count - 1) ? "," : " ");
+	}
+	fprintf(out, "};\n");
+}
+
+/**
+ * @brief Main function
+ *
+ * Writes every table to the file named on the command line.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments, the file to write
+ * @return 0 on success, 1 if the file couldn't be written
+ */
+int main(int argc, char* argv[])
+{
+	FILE* out;
+	
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s output.c\n", argv[0]);
+		return 1;
+	}
+	
+	out = fopen(argv[1], "w");
+	if (out == NULL) {
+		fprintf(stderr, "Error: Could not open %s\n", argv[1]);
+		return 1;
+	}
+	
+	fprintf(out, "/* Generated by gentables at build time, do not edit. */\n\n");
+	fprintf(out, "#include \"CardTables.h\"\n\n");
+	writeMatchMasks(out);
+	writeNames(out, "const char* const SUIT_NAMES[4]", suitNames, 4);
+	writeNames(out, "const char* const RANK_NAMES[13]", rankNames, 13);
+	fprintf(out, "\n");
+	writeCardGlyphs(out);
+	
+	if (fclose(out) != 0) {
+		fprintf(stderr, "Error: Could not write %s\n", argv[1]);
+		return 1;
+	}
+	return 0;
+}
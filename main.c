@@ -4,216 +4,221 @@
  * @author Assignment 2 Group
  * @date 21.11.2025
  *
- * This file contains the main game logic for a two-player card game.
+ * This file contains the interactive card game for 2 to MAX_PLAYERS
+ * players, two by default. The rules themselves live in Game.c, which
+ * this file wraps with console output.
+ * Output is drawn into a render buffer and written once per turn, and
+ * the -q option skips drawing altogether.
  * The game follows these rules:
  * - Each player gets 8 cards initially
  * - Players take turns playing cards that match the top card in suit or rank
  * - If a player cannot play, they pick a card from the hidden deck
  * - First player to empty their hand wins
  * - If hidden deck is empty, played cards are shuffled and reused
+ * - A game that can no longer progress ends in a draw
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "Card.h"
 #include "CardDeck.h"
+#include "Game.h"
+#include "Render.h"
+#include "MatchScan.h"
+#include "Instrument.h"
+#include "ReplayLog.h"
 #include "main.h"
+
+static RenderBuffer screen; /* everything printed during a turn, written out once per turn */
+static ReplayWriter replayLog; /* the game's replay log, used with -r */
+
 /**
- * @brief Deal cards to players from the hidden deck
- *
- * Deals the specified number of cards to each player alternately,
- * taking cards from the top of the hidden deck.
- *
- * @param hiddenDeck Pointer to the hidden deck
- * @param player1 Pointer to player 1 deck
- * @param player2 Pointer to player 2 deck
- * @param cardsPerPlayer Number of cards to deal to each player
+ * @brief Write out everything drawn since the last flush
  */
-void dealCards(CardDeck* hiddenDeck, CardDeck* player1, CardDeck* player2, int cardsPerPlayer)
+static void flushScreen(void)
 {
-	int i;
-	
-	for (i = 0; i < cardsPerPlayer; i++) {
-		Card card;
-		
-		card = removeCardFromTop(hiddenDeck);
-		addCardToTop(player1, card);
-		
-		card = removeCardFromTop(hiddenDeck);
-		addCardToTop(player2, card);
-	}
+	INSTRUMENT_TIMER_START(TIMER_OUTPUT);
+	flushRender(&screen);
+	INSTRUMENT_TIMER_STOP(TIMER_OUTPUT);
 }
 
 /**
- * @brief Handle a player's turn
+ * @brief Draw a player's hand
  *
- * Checks if the player has a matching card. If yes, plays it.
- * If no, picks a card from the hidden deck.
- *
- * @param player Pointer to the player's deck
- * @param hiddenDeck Pointer to the hidden deck
- * @param playedDeck Pointer to the played deck
- * @param playerNum Player number (1 or 2)
+ * @param game Pointer to the game
+ * @param seat Seat of the player, 0 to numPlayers - 1
  */
-void playTurn(CardDeck* player, CardDeck* hiddenDeck, CardDeck* playedDeck, int playerNum)
+void renderHand(const Game* game, int seat)
 {
-	Card topCard;
-	int matchIndex;
-	
-	topCard = peekTopCard(playedDeck);
-	matchIndex = findMatchingCard(player, topCard);
-	
-	if (matchIndex != -1) {
-		Card playedCard;
-		
-		playedCard = removeCardAtIndex(player, matchIndex);
-		addCardToTop(playedDeck, playedCard);
-		
-		printf("Player %d played card \n", playerNum);
-		printCard(playedCard);
-		printf("\n");
-	} else {
-		Card pickedCard;
-		
-		if (isDeckEmpty(hiddenDeck)) {
-			printf("Hidden deck is empty, cannot pick a card\n");
-			return;
-		}
-		
-		pickedCard = removeCardFromTop(hiddenDeck);
-		addCardToTop(player, pickedCard);
-		
-		printf("Player %d picks card \n", playerNum);
-		printCard(pickedCard);
-		printf(" from the hidden deck\n\n");
-		
-		sortDeck(player);
-	}
+	const CardDeck* hand;
 	
-	printf("Player %d cards: \n", playerNum);
-	printDeck(player);
-	printf("\n\n");
+	hand = gameHand(game, seat);
+	renderFormat(&screen, "Player %d cards: \n", seat + 1);
+	renderCards(&screen, hand->cards, hand->size);
+	renderText(&screen, "\n");
 }
 
 /**
- * @brief Refill hidden deck from played cards
+ * @brief Play the next turn and draw what happened
  *
- * When the hidden deck is empty, this function transfers all played cards
- * except the top one to the hidden deck and shuffles it.
+ * The turn itself, including any refill of the hidden deck and the check
+ * for a winner or a draw, is played by playGameTurn. This only draws the
+ * refill, the card played or picked and the player's hand.
  *
- * @param hiddenDeck Pointer to the hidden deck
- * @param playedDeck Pointer to the played deck
+ * @param game Pointer to the game, which must not be over
+ * @return What the player did
  */
-void refillHiddenDeck(CardDeck* hiddenDeck, CardDeck* playedDeck)
+TurnAction playTurn(Game* game)
 {
-	Card topCard;
-	
-	if (playedDeck->size <= 1) {
-		return;
-	}
+	TurnAction action;
+	Card card;
+	int seat, refills;
 	
-	topCard = removeCardFromTop(playedDeck);
+	INSTRUMENT_TIMER_START(TIMER_TURN);
+	seat = game->currentPlayer;
+	refills = game->refills;
+	action = playGameTurn(game, &card);
 	
-	transferCards(playedDeck, hiddenDeck);
+	if (game->refills != refills) {
+		renderText(&screen, "Hidden deck was empty. Played cards have been shuffled and moved to hidden deck.\n\n");
+	}
 	
-	shuffleDeck(hiddenDeck);
+	if (action == TURN_PLAYED) {
+		renderFormat(&screen, "Player %d played card \n", seat + 1);
+		renderCard(&screen, packCard(card));
+		renderText(&screen, "\n");
+	} else if (action == TURN_PICKED) {
+		renderFormat(&screen, "Player %d picks card \n", seat + 1);
+		renderCard(&screen, packCard(card));
+		renderText(&screen, " from the hidden deck\n\n");
+	} else {
+		renderText(&screen, "Hidden deck is empty, cannot pick a card\n");
+		INSTRUMENT_TIMER_STOP(TIMER_TURN);
+		return action;
+	}
 	
-	addCardToTop(playedDeck, topCard);
+	renderHand(game, seat);
+	INSTRUMENT_TIMER_STOP(TIMER_TURN);
 	
-	printf("Hidden deck was empty. Played cards have been shuffled and moved to hidden deck.\n\n");
+	return action;
 }
 
 /**
  * @brief Main function
  *
  * Entry point for the card game program. Handles user input,
- * initializes the game, and runs the main game loop.
+ * initializes the game, and runs the main game loop. The game is seeded
+ * from the clock, or from a number given on the command line so that a
+ * previous game can be replayed exactly. The -q option only prints the
+ * result, -r file records the game to a replay log and -p n seats 2 to
+ * MAX_PLAYERS players. A game that can no longer progress ends in a draw.
  *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments, optionally a seed, -q, -r file and -p n
  * @return 0 on successful completion
  */
-int main(void)
+int main(int argc, char* argv[])
 {
 	int numPacks;
-	CardDeck* hiddenDeck;
-	CardDeck* player1;
-	CardDeck* player2;
-	CardDeck* playedDeck;
-	Card firstCard;
-	int gameOver;
+	int numPlayers;
+	unsigned long long seed;
+	Game* game;
+	GameConfig config;
+	FILE* replayFile;
+	int quiet;
+	int seat;
+	int i;
 	
-	srand((unsigned int)time(NULL));
+	initMatchScan();
+	seed = (unsigned long long)time(NULL);
+	quiet = 0;
+	numPlayers = DEFAULT_PLAYERS;
+	replayFile = NULL;
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-q") == 0) {
+			quiet = 1;
+		} else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+			numPlayers = atoi(argv[++i]);
+			if (numPlayers < 2 || numPlayers > MAX_PLAYERS) {
+				fprintf(stderr, "Error: The game needs 2 to %d players\n", MAX_PLAYERS);
+				exit(1);
+			}
+		} else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			replayFile = fopen(argv[++i], "wb");
+			if (replayFile == NULL) {
+				fprintf(stderr, "Error: Could not open the replay log\n");
+				exit(1);
+			}
+		} else {
+			seed = strtoull(argv[i], NULL, 10);
+		}
+	}
+	initRenderBuffer(&screen, NULL, 0, stdout, quiet);
+	INSTRUMENT_REPORT_AT_EXIT();
 	
 	printf("Welcome to the Card Game!\n");
+	printf("Game seed: %llu\n", seed);
 	printf("Enter the number of packs of cards to use: ");
-	scanf_s("%d", &numPacks);
+	if (scanf("%d", &numPacks) != 1) {
+		numPacks = 0; //not a number, so treated as an invalid number below
+	}
 	
 	if (numPacks < 1) {
-		printf("Invalid number of packs. Using 1 pack.\n");
-		numPacks = 1;
+		numPacks = minPacksForPlayers(numPlayers);
+		if (numPacks == 1) {
+			printf("Invalid number of packs. Using 1 pack.\n");
+		} else {
+			printf("Invalid number of packs. Using %d packs.\n", numPacks);
+		}
+	} else if (numPacks < minPacksForPlayers(numPlayers)) {
+		numPacks = minPacksForPlayers(numPlayers);
+		printf("Not enough packs for %d players. Using %d packs.\n", numPlayers, numPacks);
 	}
 	
-	printf("\nInitializing game with %d pack(s) of cards...\n\n", numPacks);
+	printf("\nInitializing game for %d players with %d pack(s) of cards...\n\n", numPlayers, numPacks);
 	
-	hiddenDeck = createCardDeckWithPacks(numPacks);
-	shuffleDeck(hiddenDeck);
+	initGameConfig(&config, numPacks);
+	config.numPlayers = numPlayers;
 	
-	player1 = createCardDeck();
-	player2 = createCardDeck();
-	playedDeck = createCardDeck();
-	
-	dealCards(hiddenDeck, player1, player2, 8);
-	
-	sortDeck(player1);
-	sortDeck(player2);
-	
-	printf("Player 1 cards: \n");
-	printDeck(player1);
-	printf("\n");
+	INSTRUMENT_TIMER_START(TIMER_SETUP);
+	game = createGame(&config); //every deck is sized for every card, so the game makes no heap calls after this
+	if (replayFile != NULL) {
+		initReplayWriter(&replayLog, replayFile);
+		replayWriteHeader(&replayLog);
+		game->recorder = &replayLog;
+	}
+	startGame(game, (uint64_t)seed); //shuffles, deals sorted hands and turns over the first card
+	INSTRUMENT_TIMER_STOP(TIMER_SETUP);
 	
-	printf("Player 2 cards: \n");
-	printDeck(player2);
-	printf("\n\n");
+	for (seat = 0; seat < numPlayers; seat++) {
+		renderHand(game, seat);
+	}
 	
-	firstCard = removeCardFromTop(hiddenDeck);
-	addCardToTop(playedDeck, firstCard);
+	renderText(&screen, "\nFirst card: ");
+	renderCard(&screen, game->playedDeck->cards[0]);
+	renderText(&screen, "\n\n");
+	flushScreen();
 	
-	printf("\nFirst card: ");
-	printCard(firstCard);
-	printf("\n\n");
+	while (game->winner == GAME_RUNNING) {
+		playTurn(game);
+		flushScreen();
+	}
 	
-	gameOver = 0;
+	if (game->winner == GAME_DRAWN) {
+		printf("Nobody can play on. The game is a draw!\n");
+	} else {
+		printf("Player %d wins!\n", game->winner + 1);
+	}
 	
-	while (!gameOver) {
-		if (isDeckEmpty(hiddenDeck) && playedDeck->size > 1) {
-			refillHiddenDeck(hiddenDeck, playedDeck);
-		}
-		
-		playTurn(player1, hiddenDeck, playedDeck, 1);
-		
-		if (isDeckEmpty(player1)) {
-			printf("Player 1 wins!\n");
-			gameOver = 1;
-			break;
-		}
-		
-		if (isDeckEmpty(hiddenDeck) && playedDeck->size > 1) {
-			refillHiddenDeck(hiddenDeck, playedDeck);
-		}
-		
-		playTurn(player2, hiddenDeck, playedDeck, 2);
-		
-		if (isDeckEmpty(player2)) {
-			printf("Player 2 wins!\n");
-			gameOver = 1;
-			break;
-		}
+	if (replayFile != NULL) {
+		finishReplayWriter(&replayLog);
+		fclose(replayFile);
 	}
 	
-	destroyCardDeck(hiddenDeck);
-	destroyCardDeck(player1);
-	destroyCardDeck(player2);
-	destroyCardDeck(playedDeck);
+	destroyGame(game);
+	freeRenderBuffer(&screen);
 	
 	return 0;
 }
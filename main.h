@@ -11,45 +11,27 @@
 #ifndef MAIN_H
 #define MAIN_H
 
-#include "Card.h"
-#include "CardDeck.h"
-
- /**
-  * @brief Deals cards to players from the hidden deck
-  *
-  * Deals the specified number of cards to each player alternately,
-  * taking cards from the top of the hidden deck.
-  *
-  * @param hiddenDeck Pointer to the hidden deck
-  * @param player1 Pointer to player 1's deck
-  * @param player2 Pointer to player 2's deck
-  * @param cardsPerPlayer Number of cards to deal to each player
-  */
-void dealCards(CardDeck* hiddenDeck, CardDeck* player1, CardDeck* player2, int cardsPerPlayer);
+#include "Game.h"
 
 /**
- * @brief Handle a player's turn
- *
- * Checks if the player has a matching card. If yes, play it.
- * If not picks a card from the hidden deck.
+ * @brief Draw a player's hand
  *
- * @param player Pointer to the player's deck
- * @param hiddenDeck Pointer to the hidden deck
- * @param playedDeck Pointer to the played deck
- * @param playerNum Player number (1 or 2)
+ * @param game Pointer to the game
+ * @param seat Seat of the player, 0 to numPlayers - 1
  */
-void playTurn(CardDeck* player, CardDeck* hiddenDeck, CardDeck* playedDeck, int playerNum);
+void renderHand(const Game* game, int seat);
 
 /**
- * @brief Refill hidden deck from played cards
+ * @brief Play the next turn and draw what happened
  *
- * When the hidden deck is empty, this function transfers all played cards
- * except the top one to the hidden deck and shuffles it.
+ * The turn is played by playGameTurn, which also refills the hidden deck
+ * and checks for a winner or a draw. This draws the refill, the card
+ * played or picked and the player's hand.
  *
- * @param hiddenDeck Pointer to the hidden deck
- * @param playedDeck Pointer to the played deck
+ * @param game Pointer to the game, which must not be over
+ * @return What the player did
  */
-void refillHiddenDeck(CardDeck* hiddenDeck, CardDeck* playedDeck);
+TurnAction playTurn(Game* game);
 
 
 #endif /* MAIN_H */
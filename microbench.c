@@ -0,0 +1,576 @@
+/**
+ * @file microbench.c
+ * @brief Microbenchmark suite for the CardDeck operations and a full game
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a stand-alone program that times each CardDeck
+ * operation, a whole game and a game snapshot restore, on sizes from a
+ * single hand to 10,000 packs, and the cost of a turn at tables of 2 to 8
+ * players and with each player strategy, and a turn of the lockstep batch
+ * engine with each of its kernels. It works like Google Benchmark: every
+ * benchmark is run with more and more iterations until it takes at least
+ * the minimum time, and
+ * the results are printed as a table or, with --json, in Google
+ * Benchmark's JSON format so runs from different releases can be compared
+ * with its tools. It is built as the microbench target of the CMake build.
+ *
+ * Usage: microbench [--json] [--min-time=seconds] [filter]
+ *
+ * Only benchmarks whose name contains filter are run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Card.h"
+#include "CardDeck.h"
+#include "Random.h"
+#include "MatchScan.h"
+#include "Game.h"
+#include "Parallel.h"
+#include "Batch.h"
+
+#define DEFAULT_MIN_TIME 0.5        /**< seconds each benchmark runs for at least */
+#define MAX_ITERATIONS 1000000000L  /**< iterations a benchmark never goes beyond */
+#define BENCH_SEED 12345            /**< seed of every deck and game used */
+#define BENCH_MAX_TURNS 100000      /**< turns before a benchmarked game is given up */
+
+/**
+ * @brief State of one run of a benchmark
+ *
+ * The benchmark does its setup, calls startTiming, repeats the operation
+ * iterations times, calls stopTiming and then cleans up, so only the
+ * operation itself is timed.
+ */
+typedef struct {
+	int arg;                  /**< size the benchmark is run at, in cards or packs */
+	long iterations;          /**< times to repeat the operation */
+	long long items;          /**< cards or games handled by all the iterations, set by the benchmark */
+	double realTime;          /**< wall clock seconds between startTiming and stopTiming */
+	double cpuTime;           /**< processor seconds between startTiming and stopTiming */
+	struct timespec realStart;
+	clock_t cpuStart;
+} BenchState;
+
+/**
+ * @brief A benchmark and the sizes it is run at
+ */
+typedef struct {
+	const char* name;              /**< name reported for the benchmark */
+	void (*run)(BenchState*);      /**< function that runs the benchmark once */
+	const int* args;               /**< sizes to run it at */
+	int numArgs;                   /**< number of sizes */
+} Benchmark;
+
+static void startTiming(BenchState* state)
+{
+	timespec_get(&state->realStart, TIME_UTC);
+	state->cpuStart = clock();
+}
+
+static void stopTiming(BenchState* state)
+{
+	struct timespec end;
+	
+	state->cpuTime = (double)(clock() - state->cpuStart) / CLOCKS_PER_SEC;
+	timespec_get(&end, TIME_UTC);
+	state->realTime = (double)(end.tv_sec - state->realStart.tv_sec) + (end.tv_nsec - state->realStart.tv_nsec) / 1e9;
+}
+
+/*
+ * Creates a deck of exactly numCards shuffled cards.
+ */
+static CardDeck* createBenchDeck(int numCards)
+{
+	CardDeck* deck;
+	Rng rng;
+	
+	deck = createCardDeckWithPacks(numCards / 52 + 1);
+	rngSeed(&rng, BENCH_SEED);
+	shuffleDeck(deck, &rng);
+	deck->size = numCards;
+	
+	return deck;
+}
+
+/*
+ * Fills a deck with numCards cards and empties it again, every iteration.
+ */
+static void benchAddCardToTop(BenchState* state)
+{
+	CardDeck* deck;
+	long it;
+	int i;
+	
+	deck = createCardDeck();
+	reserveDeck(deck, state->arg);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		for (i = 0; i < state->arg; i++) {
+			addPackedCardToTop(deck, (PackedCard)(i & 0x3F));
+		}
+		clearDeck(deck);
+	}
+	stopTiming(state);
+	
+	state->items = (long long)state->iterations * state->arg;
+	destroyCardDeck(deck);
+}
+
+/*
+ * Removes the middle card and puts it back on top, so the size stays the
+ * same and every removal shifts half the deck.
+ */
+static void benchRemoveCardAtIndex(BenchState* state)
+{
+	CardDeck* deck;
+	long it;
+	
+	deck = createBenchDeck(state->arg);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		addCardToTop(deck, removeCardAtIndex(deck, deck->size / 2));
+	}
+	stopTiming(state);
+	
+	state->items = state->iterations;
+	destroyCardDeck(deck);
+}
+
+static void benchShuffleDeck(BenchState* state)
+{
+	CardDeck* deck;
+	Rng rng;
+	long it;
+	
+	deck = createBenchDeck(state->arg);
+	rngSeed(&rng, BENCH_SEED);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		shuffleDeck(deck, &rng);
+	}
+	stopTiming(state);
+	
+	state->items = (long long)state->iterations * state->arg;
+	destroyCardDeck(deck);
+}
+
+/*
+ * Restores the same shuffled order with a memcpy before every sort, which
+ * is included in the time.
+ */
+static void benchSortDeck(BenchState* state)
+{
+	CardDeck* deck;
+	PackedCard* unsorted;
+	long it;
+	
+	deck = createBenchDeck(state->arg);
+	unsorted = (PackedCard*)malloc((size_t)state->arg);
+	if (unsorted == NULL) {
+		fprintf(stderr, "Error: Memory allocation failed\n");
+		exit(1);
+	}
+	memcpy(unsorted, deck->cards, (size_t)state->arg);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		memcpy(deck->cards, unsorted, (size_t)state->arg);
+		sortDeck(deck);
+	}
+	stopTiming(state);
+	
+	state->items = (long long)state->iterations * state->arg;
+	free(unsorted);
+	destroyCardDeck(deck);
+}
+
+/*
+ * Only the last card matches, so every search looks at every card.
+ */
+static void benchFindMatchingCard(BenchState* state)
+{
+	CardDeck* deck;
+	Card target;
+	long long found;
+	long it;
+	int i;
+	
+	deck = createCardDeck();
+	for (i = 0; i < state->arg - 1; i++) {
+		addCardToTop(deck, (Card){ (Suit)(i % 3), (Rank)(i % 12) }); //never the suit or rank of the target
+	}
+	target = (Card){ DIAMOND, ACE };
+	addCardToTop(deck, target);
+	found = 0;
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		found += findMatchingCard(deck, target);
+	}
+	stopTiming(state);
+	
+	if (found != (long long)state->iterations * (state->arg - 1)) {
+		fprintf(stderr, "Error: findMatchingCard found the wrong card\n");
+		exit(1);
+	}
+	
+	state->items = (long long)state->iterations * state->arg;
+	destroyCardDeck(deck);
+}
+
+/*
+ * Moves every card onto a deck that isn't empty, so the cards are copied
+ * rather than the arrays swapped. The sizes are then put back, which
+ * leaves the source holding the same cards for the next iteration.
+ */
+static void benchTransferCards(BenchState* state)
+{
+	CardDeck* source;
+	CardDeck* dest;
+	long it;
+	
+	source = createBenchDeck(state->arg);
+	dest = createCardDeck();
+	reserveDeck(dest, state->arg + 1);
+	addPackedCardToTop(dest, 0);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		transferCards(source, dest);
+		source->size = state->arg;
+		dest->size = 1;
+	}
+	stopTiming(state);
+	
+	state->items = (long long)state->iterations * state->arg;
+	destroyCardDeck(source);
+	destroyCardDeck(dest);
+}
+
+/*
+ * Plays a whole silent game with arg packs, with a new seed every time.
+ */
+static void benchFullGame(BenchState* state)
+{
+	GameConfig config;
+	Game* game;
+	long it;
+	
+	initGameConfig(&config, state->arg);
+	game = createGame(&config);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		startGame(game, BENCH_SEED + (uint64_t)it);
+		playGame(game, BENCH_MAX_TURNS);
+	}
+	stopTiming(state);
+	
+	state->items = state->iterations;
+	destroyGame(game);
+}
+
+/*
+ * Restores a mid-game snapshot and plays one turn from it, as a search
+ * would when trying each branch from the same position.
+ */
+static void benchSnapshotRestore(BenchState* state)
+{
+	GameConfig config;
+	GameSnapshot* snapshot;
+	Game* game;
+	Arena* arena;
+	Card card;
+	long it;
+	int t;
+	
+	initGameConfig(&config, state->arg);
+	game = createGame(&config);
+	startGame(game, BENCH_SEED);
+	for (t = 0; t < 10 && game->winner == GAME_RUNNING; t++) {
+		playGameTurn(game, &card);
+	}
+	arena = createArena(gameSnapshotSize(game));
+	snapshot = createGameSnapshot(arena, game);
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		restoreGameSnapshot(game, snapshot);
+		playGameTurn(game, &card);
+	}
+	stopTiming(state);
+	
+	state->items = state->iterations;
+	destroyArena(arena);
+	destroyGame(game);
+}
+
+/*
+ * Plays whole silent games with arg players and two packs, so there are
+ * enough cards for any table. Items are turns, so items/s shows the cost
+ * of a turn as seats are added.
+ */
+static void benchTableTurns(BenchState* state)
+{
+	GameConfig config;
+	Game* game;
+	long long turns;
+	long it;
+	
+	initGameConfig(&config, minPacksForPlayers(MAX_PLAYERS));
+	config.numPlayers = state->arg;
+	game = createGame(&config);
+	turns = 0;
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		startGame(game, BENCH_SEED + (uint64_t)it);
+		playGame(game, BENCH_MAX_TURNS);
+		turns += game->turns;
+	}
+	stopTiming(state);
+	
+	state->items = turns;
+	destroyGame(game);
+}
+
+/*
+ * Plays whole two-player games with one pack where both players use the
+ * strategy numbered arg. Items are turns, so items/s shows what choosing
+ * a card costs next to the first match.
+ */
+static void benchStrategyTurns(BenchState* state)
+{
+	GameConfig config;
+	Game* game;
+	long long turns;
+	long it;
+	
+	initGameConfig(&config, 1);
+	config.strategies[0] = (unsigned char)state->arg;
+	config.strategies[1] = (unsigned char)state->arg;
+	game = createGame(&config);
+	turns = 0;
+	
+	startTiming(state);
+	for (it = 0; it < state->iterations; it++) {
+		startGame(game, BENCH_SEED + (uint64_t)it);
+		playGame(game, BENCH_MAX_TURNS);
+		turns += game->turns;
+	}
+	stopTiming(state);
+	
+	state->items = turns;
+	destroyGame(game);
+}
+
+/*
+ * Plays two-player one-pack games in lockstep batches with the batch
+ * kernels numbered arg. Each iteration is one game, and items are turns so
+ * items/s compares with strategyTurns/0. Kernels this processor can't run
+ * are timed with the scalar ones.
+ */
+static void benchBatchTurns(BenchState* state)
+{
+	GameConfig config;
+	GameBatch* batch;
+	SimStats stats;
+	
+	initGameConfig(&config, 1);
+	batch = createGameBatch(&config);
+	useBatchKernels(batch, (BatchKernelKind)state->arg);
+	initSimStats(&stats);
+	startGameBatch(batch, BENCH_SEED, 0, state->iterations);
+	
+	startTiming(state);
+	while (stepGameBatch(batch, &stats)) {
+	}
+	stopTiming(state);
+	
+	state->items = stats.totalTurns;
+	destroyGameBatch(batch);
+}
+
+static const int cardSizes[] = { 8, 52, 520, 5200, 52000, 520000 }; /* a hand up to 10,000 packs */
+static const int packSizes[] = { 1, 10, 100, 1000, 10000 };
+static const int seatCounts[] = { 2, 3, 4, 5, 6, 7, 8 };
+static const int strategyIds[] = { STRATEGY_FIRST_MATCH, STRATEGY_LONGEST_SUIT, STRATEGY_HIGH_RANK, STRATEGY_LOOKAHEAD };
+static const int batchKernels[] = { BATCH_KERNEL_SCALAR, BATCH_KERNEL_AVX2 };
+
+#define COUNT_OF(array) ((int)(sizeof(array) / sizeof((array)[0])))
+
+static const Benchmark benchmarks[] = {
+	{ "addCardToTop", benchAddCardToTop, cardSizes, COUNT_OF(cardSizes) },
+	{ "removeCardAtIndex", benchRemoveCardAtIndex, cardSizes, COUNT_OF(cardSizes) },
+	{ "shuffleDeck", benchShuffleDeck, cardSizes, COUNT_OF(cardSizes) },
+	{ "sortDeck", benchSortDeck, cardSizes, COUNT_OF(cardSizes) },
+	{ "findMatchingCard", benchFindMatchingCard, cardSizes, COUNT_OF(cardSizes) },
+	{ "transferCards", benchTransferCards, cardSizes, COUNT_OF(cardSizes) },
+	{ "fullGame", benchFullGame, packSizes, COUNT_OF(packSizes) },
+	{ "snapshotRestore", benchSnapshotRestore, packSizes, COUNT_OF(packSizes) },
+	{ "tableTurns", benchTableTurns, seatCounts, COUNT_OF(seatCounts) },
+	{ "strategyTurns", benchStrategyTurns, strategyIds, COUNT_OF(strategyIds) },
+	{ "batchTurns", benchBatchTurns, batchKernels, COUNT_OF(batchKernels) }
+};
+
+/**
+ * @brief Run one benchmark at one size until it takes the minimum time
+ *
+ * Starts with one iteration and, like Google Benchmark, multiplies the
+ * iterations by up to 10 each time, aiming just past the minimum time.
+ *
+ * @param bench The benchmark to run
+ * @param arg The size to run it at
+ * @param minTime Minimum seconds the final run must take
+ * @param state Pointer to the state, filled in with the final run
+ */
+static void runBenchmark(const Benchmark* bench, int arg, double minTime, BenchState* state)
+{
+	double multiplier;
+	long next;
+	
+	state->arg = arg;
+	state->iterations = 1;
+	
+	for (;;) {
+		state->items = 0;
+		bench->run(state);
+		
+		if (state->realTime >= minTime || state->iterations >= MAX_ITERATIONS) {
+			return;
+		}
+		
+		multiplier = (state->realTime > minTime / 10) ? minTime * 1.4 / state->realTime : 10.0;
+		next = (long)(state->iterations * multiplier);
+		if (next <= state->iterations) {
+			next = state->iterations + 1;
+		}
+		state->iterations = (next > MAX_ITERATIONS) ? MAX_ITERATIONS : next;
+	}
+}
+
+static void printTableHeader(void)
+{
+	printf("%-28s %14s %14s %14s %14s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations", "items/s");
+	printf("------------------------------------------------------------------------------------------\n");
+}
+
+static void printTableRow(const char* name, const BenchState* state)
+{
+	printf("%-28s %14.1f %14.1f %14ld %14.4g\n", name,
+	       state->realTime * 1e9 / state->iterations, state->cpuTime * 1e9 / state->iterations,
+	       state->iterations, state->cpuTime > 0 ? state->items / state->cpuTime : 0.0);
+}
+
+static void printJsonHeader(void)
+{
+	char date[64];
+	time_t now;
+	
+	now = time(NULL);
+	strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+	
+	printf("{\n");
+	printf("  \"context\": {\n");
+	printf("    \"date\": \"%s\",\n", date);
+	printf("    \"executable\": \"microbench\",\n");
+	printf("    \"num_cpus\": %d,\n", countProcessors());
+#ifdef NDEBUG
+	printf("    \"library_build_type\": \"release\"\n");
+#else
+	printf("    \"library_build_type\": \"debug\"\n");
+#endif
+	printf("  },\n");
+	printf("  \"benchmarks\": [");
+}
+
+static void printJsonRow(const char* name, const BenchState* state, int first)
+{
+	printf("%s\n    {\n", first ? "" : ",");
+	printf("      \"name\": \"%s\",\n", name);
+	printf("      \"run_name\": \"%s\",\n", name);
+	printf("      \"run_type\": \"iteration\",\n");
+	printf("      \"repetitions\": 1,\n");
+	printf("      \"repetition_index\": 0,\n");
+	printf("      \"threads\": 1,\n");
+	printf("      \"iterations\": %ld,\n", state->iterations);
+	printf("      \"real_time\": %.6e,\n", state->realTime * 1e9 / state->iterations);
+	printf("      \"cpu_time\": %.6e,\n", state->cpuTime * 1e9 / state->iterations);
+	printf("      \"time_unit\": \"ns\",\n");
+	printf("      \"items_per_second\": %.6e\n", state->cpuTime > 0 ? state->items / state->cpuTime : 0.0);
+	printf("    }");
+	fflush(stdout);
+}
+
+/**
+ * @brief Main function
+ *
+ * Reads the options, then runs every benchmark whose name contains the
+ * filter at each of its sizes and prints the results.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 on successful completion
+ */
+int main(int argc, char* argv[])
+{
+	const char* filter;
+	double minTime;
+	int json, first;
+	int b, a, i;
+	BenchState state;
+	char name[64];
+	
+	initMatchScan();
+	filter = "";
+	minTime = DEFAULT_MIN_TIME;
+	json = 0;
+	
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) {
+			json = 1;
+		} else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+			minTime = atof(argv[i] + 11);
+		} else if (argv[i][0] != '-') {
+			filter = argv[i];
+		} else {
+			fprintf(stderr, "Usage: %s [--json] [--min-time=seconds] [filter]\n", argv[0]);
+			return 1;
+		}
+	}
+	
+	if (json) {
+		printJsonHeader();
+	} else {
+		printTableHeader();
+	}
+	
+	first = 1;
+	for (b = 0; b < COUNT_OF(benchmarks); b++) {
+		if (strstr(benchmarks[b].name, filter) == NULL) {
+			continue;
+		}
+		for (a = 0; a < benchmarks[b].numArgs; a++) {
+			snprintf(name, sizeof(name), "%s/%d", benchmarks[b].name, benchmarks[b].args[a]);
+			runBenchmark(&benchmarks[b], benchmarks[b].args[a], minTime, &state);
+			if (json) {
+				printJsonRow(name, &state, first);
+			} else {
+				printTableRow(name, &state);
+			}
+			first = 0;
+		}
+	}
+	
+	if (json) {
+		printf("\n  ]\n}\n");
+	}
+	
+	return 0;
+}
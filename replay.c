@@ -0,0 +1,184 @@
+/**
+ * @file replay.c
+ * @brief Command line program that reads replay logs
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a program that checks and replays the games in a
+ * replay log written by simulate --record or by the game's -r option.
+ *
+ * Usage: replay file              check every game in the log
+ *        replay file game [turn]  show the state of a game after a turn
+ *
+ * Games are numbered from 0 in the order they are in the log. Without a
+ * turn, the state at the end of the game is shown.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Game.h"
+#include "Render.h"
+#include "MatchScan.h"
+#include "ReplayLog.h"
+
+/**
+ * @brief Get a game that plays with the recorded settings
+ *
+ * Reuses the game if it was created with the same settings, otherwise
+ * destroys it and creates a new one.
+ *
+ * @param game Pointer to the current game, or NULL
+ * @param record Pointer to the recorded game
+ * @return Pointer to a game with the recorded settings
+ */
+static Game* gameForRecord(Game* game, const ReplayRecord* record)
+{
+	if (game != NULL && game->config.numPacks == record->config.numPacks
+	    && game->config.numPlayers == record->config.numPlayers && game->config.useShoe == record->config.useShoe
+	    && memcmp(game->config.strategies, record->config.strategies, sizeof(record->config.strategies)) == 0) {
+		return game;
+	}
+	
+	destroyGame(game);
+	return createGame(&record->config);
+}
+
+/**
+ * @brief Print how a game ended
+ *
+ * @param winner The winning player, GAME_DRAWN or GAME_RUNNING
+ */
+static void printResult(int winner)
+{
+	if (winner >= 0) {
+		printf("player %d won", winner + 1);
+	} else if (winner == GAME_DRAWN) {
+		printf("a draw");
+	} else {
+		printf("stopped at the turn limit");
+	}
+}
+
+/**
+ * @brief Print the state of a replayed game
+ *
+ * @param game Pointer to the replayed game
+ */
+static void printGameState(Game* game)
+{
+	RenderBuffer screen;
+	int p;
+	
+	initRenderBuffer(&screen, NULL, 0, stdout, 0);
+	
+	renderFormat(&screen, "Turn %d, player %d to play", game->turns, game->currentPlayer + 1);
+	if (game->winner >= 0) {
+		renderFormat(&screen, ", player %d has won", game->winner + 1);
+	} else if (game->winner == GAME_DRAWN) {
+		renderText(&screen, ", the game is a draw");
+	}
+	renderFormat(&screen, "\nHidden cards: %d, played cards: %d, refills: %d, stalls: %d\n\n",
+	             game->shoe != NULL ? game->shoe->total : game->hiddenDeck->size,
+	             game->playedDeck->size, game->refills, game->stalls);
+	
+	for (p = 0; p < game->numPlayers; p++) {
+		renderFormat(&screen, "Player %d cards (%s): \n", p + 1, strategyName((StrategyId)game->config.strategies[p]));
+		renderCards(&screen, game->players[p]->cards, game->players[p]->size);
+		renderText(&screen, "\n");
+	}
+	
+	renderText(&screen, "Top card: ");
+	renderCard(&screen, game->playedDeck->cards[game->playedDeck->size - 1]);
+	renderText(&screen, "\n");
+	
+	flushRender(&screen);
+	freeRenderBuffer(&screen);
+}
+
+/**
+ * @brief Main function
+ *
+ * Reads the log named on the command line. Either replays every game in
+ * it and reports any that no longer play or end the same way, or
+ * replays one game up to a turn and prints its state.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 if every replayed game matched its log, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+	FILE* in;
+	ReplayRecord record;
+	Game* game;
+	long long gameNumber, wanted, games, turns, mismatches;
+	int turn, matched;
+	
+	if (argc < 2 || argc > 4) {
+		fprintf(stderr, "Usage: %s file [game [turn]]\n", argv[0]);
+		return 1;
+	}
+	
+	in = fopen(argv[1], "rb");
+	if (in == NULL || !replayReadHeader(in)) {
+		fprintf(stderr, "Error: %s is not a replay log\n", argv[1]);
+		return 1;
+	}
+	
+	initMatchScan();
+	wanted = (argc > 2) ? strtoll(argv[2], NULL, 10) : -1;
+	turn = (argc > 3) ? atoi(argv[3]) : -1;
+	
+	initReplayRecord(&record);
+	game = NULL;
+	games = 0;
+	turns = 0;
+	mismatches = 0;
+	
+	for (gameNumber = 0; replayReadGame(in, &record); gameNumber++) {
+		if (wanted >= 0 && gameNumber != wanted) {
+			continue;
+		}
+		
+		game = gameForRecord(game, &record);
+		matched = replayToTurn(game, &record, (turn >= 0 && wanted >= 0) ? turn : record.numTurns);
+		games++;
+		turns += matched;
+		
+		if (matched < record.numTurns && (turn < 0 || matched < turn)) {
+			mismatches++;
+			printf("Game %lld (seed %llu, %d pack(s)) differs from the log at turn %d\n",
+			       gameNumber, (unsigned long long)record.seed, record.config.numPacks, matched);
+		} else if (matched == record.numTurns && game->winner != record.winner) {
+			mismatches++;
+			printf("Game %lld (seed %llu, %d pack(s)) ends differently from the log: the log has ",
+			       gameNumber, (unsigned long long)record.seed, record.config.numPacks);
+			printResult(record.winner);
+			printf(", the replay has ");
+			printResult(game->winner);
+			printf("\n");
+		}
+		
+		if (wanted >= 0) {
+			printf("Game %lld: seed %llu, %d pack(s), %d players%s, %d turns recorded\n\n", gameNumber,
+			       (unsigned long long)record.seed, record.config.numPacks, record.config.numPlayers,
+			       record.config.useShoe ? " in a shoe" : "", record.numTurns);
+			printGameState(game);
+			break;
+		}
+	}
+	
+	if (wanted >= 0 && games == 0) {
+		fprintf(stderr, "Error: The log has no game %lld\n", wanted);
+		mismatches = 1;
+	} else if (wanted < 0) {
+		printf("Replayed %lld games, %lld turns, %lld differ from the log\n", games, turns, mismatches);
+	}
+	
+	freeReplayRecord(&record);
+	destroyGame(game);
+	fclose(in);
+	
+	return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file simulate.c
+ * @brief Command line program for the headless batch simulator
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a program that plays a batch of seeded games without
+ * any per-turn output and prints the statistics and the time taken.
+ *
+ * Usage: simulate [--shoe] [--batch] [--record=file] [--players=n] [--strategies=list] [games] [seed] [packs] [threads]
+ *
+ * --shoe keeps the hidden cards as a CardShoe of counts, so very large
+ * numbers of packs cost no more memory or setup time than one.
+ * --batch plays one-pack games BATCH_LANES at a time in lockstep with the
+ * batch engine, for sweeps where only the statistics matter.
+ * --record writes every game to a replay log that the replay program reads.
+ * --players seats 2 to 8 players at each table, 2 by default. packs
+ * defaults to the fewest that deal every hand.
+ * --strategies gives each seat a strategy from a comma separated list of
+ * first, longest-suit, high-rank and lookahead, repeating the list round
+ * the table. Every player plays the first match by default.
+ * threads defaults to the number of processors. The statistics for a given
+ * seed are the same whatever the number of threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Simulator.h"
+#include "Parallel.h"
+#include "Instrument.h"
+#include "Batch.h"
+
+/**
+ * @brief Main function
+ *
+ * Reads the number of games, seed, number of packs and number of threads
+ * from the command line, along with the --shoe, --batch, --record,
+ * --players and --strategies options, runs the simulation and prints the
+ * results.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 on successful completion
+ */
+int main(int argc, char* argv[])
+{
+	const char* args[4] = { NULL, NULL, NULL, NULL };
+	const char* recordPath;
+	int strategies[MAX_PLAYERS];
+	long long numGames;
+	unsigned long long seed;
+	int numThreads;
+	int numArgs, useShoe, useBatch, numPlayers, numStrategies, i;
+	GameConfig config;
+	SimStats stats;
+	struct timespec start, end;
+	double elapsed;
+	
+	numArgs = 0;
+	useShoe = 0;
+	useBatch = 0;
+	numPlayers = DEFAULT_PLAYERS;
+	recordPath = NULL;
+	strategies[0] = STRATEGY_FIRST_MATCH;
+	numStrategies = 1;
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--shoe") == 0) {
+			useShoe = 1;
+		} else if (strcmp(argv[i], "--batch") == 0) {
+			useBatch = 1;
+		} else if (strncmp(argv[i], "--record=", 9) == 0) {
+			recordPath = argv[i] + 9;
+		} else if (strncmp(argv[i], "--players=", 10) == 0) {
+			numPlayers = atoi(argv[i] + 10);
+		} else if (strncmp(argv[i], "--strategies=", 13) == 0) {
+			numStrategies = parseStrategyList(argv[i] + 13, strategies, MAX_PLAYERS);
+		} else if (numArgs < 4) {
+			args[numArgs++] = argv[i];
+		} else {
+			numArgs = -1; //too many arguments
+			break;
+		}
+	}
+	
+	numGames = (args[0] != NULL) ? strtoll(args[0], NULL, 10) : 1000000;
+	seed = (args[1] != NULL) ? strtoull(args[1], NULL, 10) : 1;
+	initGameConfig(&config, (args[2] != NULL) ? atoi(args[2]) : minPacksForPlayers(numPlayers));
+	config.numPlayers = numPlayers;
+	config.useShoe = useShoe;
+	numThreads = (args[3] != NULL) ? atoi(args[3]) : countProcessors();
+	for (i = 0; i < MAX_PLAYERS && numStrategies > 0; i++) {
+		config.strategies[i] = (unsigned char)strategies[i % numStrategies]; //the list repeats round the table
+	}
+	
+	if (numArgs < 0 || numStrategies < 1 || numGames < 1 || numPlayers < 2 || numPlayers > MAX_PLAYERS
+	    || config.numPacks < minPacksForPlayers(numPlayers) || numThreads < 1) {
+		fprintf(stderr, "Usage: %s [--shoe] [--batch] [--record=file] [--players=n] [--strategies=list] [games] [seed] [packs] [threads]\n",
+		        argv[0]);
+		fprintf(stderr, "Strategies are first, longest-suit, high-rank and lookahead\n");
+		fprintf(stderr, "Players must be 2 to %d, with at least %d pack(s) for %d players\n", MAX_PLAYERS,
+		        minPacksForPlayers(numPlayers < 2 || numPlayers > MAX_PLAYERS ? MAX_PLAYERS : numPlayers),
+		        numPlayers < 2 || numPlayers > MAX_PLAYERS ? MAX_PLAYERS : numPlayers);
+		return 1;
+	}
+	if (useBatch && (recordPath != NULL || !batchSupportsConfig(&config))) {
+		fprintf(stderr, "Error: --batch plays one pack without --shoe or --record, with 2 to %d players on the first match\n",
+		        BATCH_MAX_PLAYERS);
+		return 1;
+	}
+	
+	printf("Simulating %lld games with %d players, %d pack(s)%s%s, seed %llu, %d thread(s)\n\n",
+	       numGames, numPlayers, config.numPacks, useShoe ? " in a shoe" : "", useBatch ? " in lockstep batches" : "",
+	       seed, numThreads);
+	if (numStrategies > 1 || strategies[0] != STRATEGY_FIRST_MATCH) {
+		printf("Strategies:");
+		for (i = 0; i < numPlayers; i++) {
+			printf(" %s", strategyName((StrategyId)config.strategies[i]));
+		}
+		printf("\n\n");
+	}
+	
+	timespec_get(&start, TIME_UTC); //wall clock time, clock() would add up every thread's time
+	if (useBatch) {
+		runParallelBatchSimulation(numGames, (uint64_t)seed, &config, numThreads, &stats);
+	} else {
+		runParallelSimulation(numGames, (uint64_t)seed, &config, numThreads, recordPath, &stats);
+	}
+	timespec_get(&end, TIME_UTC);
+	elapsed = (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	
+	printSimStats(&stats, stdout);
+	INSTRUMENT_REPORT(stdout);
+	printf("\nTime: %.3f s (%.0f games per minute)\n", elapsed,
+	       elapsed > 0 ? 60.0 * numGames / elapsed : 0.0);
+	
+	return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file tournament.c
+ * @brief Command line program that plays strategies against each other
+ * @author Assignment 2 Group
+ * @date 16.10.2026
+ *
+ * This file contains a round robin tournament between player strategies.
+ * Each pair of strategies plays the same seeded deals twice, once with
+ * each strategy in the first seat, so neither gains from moving first or
+ * from a lucky deal. The games run on every processor through
+ * runParallelSimulation, and each win rate is shown with a 95% Wilson
+ * confidence interval over the games that had a winner.
+ *
+ * Usage: tournament [--strategies=list] [games] [seed] [packs] [threads]
+ *
+ * --strategies is a comma separated list of first, longest-suit,
+ * high-rank and lookahead, all of them by default. games is the number
+ * of games each pair plays, 1000000 by default, split between the two
+ * seatings. packs defaults to 1 and threads to the number of processors.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "Simulator.h"
+#include "Parallel.h"
+#include "Strategy.h"
+
+#define CONFIDENCE_Z 1.959964 /**< normal quantile for a 95% confidence interval */
+
+/**
+ * @brief Results of one strategy against the rest of the field
+ */
+typedef struct {
+	long long wins;    /**< games the strategy won */
+	long long losses;  /**< games the other strategy won */
+	long long draws;   /**< games nobody won, drawn or stopped by the turn limit */
+} Score;
+
+/**
+ * @brief Print a win rate with its 95% Wilson confidence interval
+ *
+ * The Wilson interval stays inside 0% to 100% and is accurate even when
+ * the win rate is close to either end.
+ *
+ * @param wins Games won
+ * @param losses Games lost
+ */
+static void printWinRate(long long wins, long long losses)
+{
+	double n, p, z2, centre, halfWidth;
+	
+	n = (double)(wins + losses);
+	if (n == 0) {
+		printf("     -  ");
+		return;
+	}
+	
+	p = wins / n;
+	z2 = CONFIDENCE_Z * CONFIDENCE_Z;
+	centre = (p + z2 / (2 * n)) / (1 + z2 / n);
+	halfWidth = CONFIDENCE_Z * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+	
+	printf("%6.2f%% [%6.2f%%, %6.2f%%]", 100 * p, 100 * (centre - halfWidth), 100 * (centre + halfWidth));
+}
+
+/**
+ * @brief Play one strategy against another from both seats
+ *
+ * @param first Strategy of the first player
+ * @param second Strategy of the second player
+ * @param numGames Number of games, split between the two seatings
+ * @param seed Seed of the simulation, the same for both seatings
+ * @param config Pointer to the settings of each game
+ * @param numThreads Number of worker threads
+ * @param score Set to the first strategy's results
+ */
+static void playPair(int first, int second, long long numGames, uint64_t seed, GameConfig* config,
+                     int numThreads, Score* score)
+{
+	SimStats stats;
+	long long games;
+	int seating, seat;
+	
+	score->wins = 0;
+	score->losses = 0;
+	score->draws = 0;
+	
+	for (seating = 0; seating < 2; seating++) {
+		games = (seating == 0) ? numGames / 2 : numGames - numGames / 2;
+		if (games == 0) {
+			continue;
+		}
+		seat = seating; //seat the first strategy plays from
+		config->strategies[seat] = (unsigned char)first;
+		config->strategies[1 - seat] = (unsigned char)second;
+		runParallelSimulation(games, seed, config, numThreads, NULL, &stats);
+		
+		score->wins += stats.wins[seat];
+		score->losses += stats.wins[1 - seat];
+		score->draws += stats.draws + stats.unfinished;
+	}
+}
+/*
+PSEUDOCODE:
+1) Clear the score
+2) Loop over the two seatings, the first strategy in seat 1 and then in seat 2
+	3) Give each seat its strategy and play half the games from the same seed
+	4) Add the first strategy's wins, the other strategy's wins and the games without a winner to the score
+*/
+
+/**
+ * @brief Main function
+ *
+ * Reads the strategies, number of games, seed, number of packs and number
+ * of threads from the command line, plays every pair of strategies and
+ * prints each pairing and each strategy's results against the field.
+ *
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments
+ * @return 0 on successful completion
+ */
+int main(int argc, char* argv[])
+{
+	const char* args[4] = { NULL, NULL, NULL, NULL };
+	int strategies[NUM_STRATEGIES];
+	Score totals[NUM_STRATEGIES];
+	Score score;
+	long long numGames;
+	unsigned long long seed;
+	int numStrategies, numThreads, numArgs, i, j;
+	GameConfig config;
+	struct timespec start, end;
+	double elapsed;
+	
+	numArgs = 0;
+	numStrategies = NUM_STRATEGIES;
+	for (i = 0; i < NUM_STRATEGIES; i++) {
+		strategies[i] = i;
+	}
+	for (i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--strategies=", 13) == 0) {
+			numStrategies = parseStrategyList(argv[i] + 13, strategies, NUM_STRATEGIES);
+		} else if (numArgs < 4) {
+			args[numArgs++] = argv[i];
+		} else {
+			numArgs = -1; //too many arguments
+			break;
+		}
+	}
+	
+	numGames = (args[0] != NULL) ? strtoll(args[0], NULL, 10) : 1000000;
+	seed = (args[1] != NULL) ? strtoull(args[1], NULL, 10) : 1;
+	initGameConfig(&config, (args[2] != NULL) ? atoi(args[2]) : 1);
+	numThreads = (args[3] != NULL) ? atoi(args[3]) : countProcessors();
+	
+	if (numArgs < 0 || numStrategies < 2 || numGames < 1 || config.numPacks < 1 || numThreads < 1) {
+		fprintf(stderr, "Usage: %s [--strategies=list] [games] [seed] [packs] [threads]\n", argv[0]);
+		fprintf(stderr, "The list needs two or more of first, longest-suit, high-rank and lookahead\n");
+		return 1;
+	}
+	
+	printf("Tournament of %d strategies, %lld games a pair, %d pack(s), seed %llu, %d thread(s)\n\n",
+	       numStrategies, numGames, config.numPacks, seed, numThreads);
+	printf("%-13s %-13s %-29s %s\n", "Strategy", "Against", "Win rate [95% interval]", "No winner");
+	
+	memset(totals, 0, sizeof(totals));
+	timespec_get(&start, TIME_UTC);
+	for (i = 0; i < numStrategies; i++) {
+		for (j = i + 1; j < numStrategies; j++) {
+			playPair(strategies[i], strategies[j], numGames, (uint64_t)seed, &config, numThreads, &score);
+			
+			printf("%-13s %-13s ", strategyName((StrategyId)strategies[i]), strategyName((StrategyId)strategies[j]));
+			printWinRate(score.wins, score.losses);
+			printf("   %lld\n", score.draws);
+			
+			totals[i].wins += score.wins;
+			totals[i].losses += score.losses;
+			totals[i].draws += score.draws;
+			totals[j].wins += score.losses;
+			totals[j].losses += score.wins;
+			totals[j].draws += score.draws;
+		}
+	}
+	timespec_get(&end, TIME_UTC);
+	elapsed = (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	
+	printf("\n%-27s %-29s %s\n", "Against the field", "Win rate [95% interval]", "No winner");
+	for (i = 0; i < numStrategies; i++) {
+		printf("%-27s ", strategyName((StrategyId)strategies[i]));
+		printWinRate(totals[i].wins, totals[i].losses);
+		printf("   %lld\n", totals[i].draws);
+	}
+	
+	printf("\nTime: %.3f s (%.0f games per minute)\n", elapsed,
+	       elapsed > 0 ? 60.0 * numGames * (numStrategies * (numStrategies - 1) / 2) / elapsed : 0.0);
+	
+	return 0;
+}